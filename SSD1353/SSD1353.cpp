@@ -14,8 +14,37 @@
  */
 
 #include "SSD1353.h"
+#include "SSD1353Font.h"
+#include "SSD1353Strokes.h"
 #include <Arduino.h>
 
+#if !SSD1353_CLIP_DEPTH
+const SSD1353Rect SSD1353Base::_clip[1] = {{0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1}};
+#endif
+
+#ifdef SSD1353_STATS
+// Counts a primitive call and its time, unless it runs inside another primitive
+class SSD1353Base::StatScope {
+  public:
+  StatScope(SSD1353Base& display, uint8_t slot)
+      : _display(display), _slot(slot), _start(micros()) {
+    _display._statDepth++;
+  }
+
+  ~StatScope() {
+    if (--_display._statDepth)
+      return;
+    _display._stats.calls[_slot]++;
+    _display._stats.micros[_slot] += micros() - _start;
+  }
+
+  private:
+  SSD1353Base& _display;
+  uint8_t _slot;
+  uint32_t _start;
+};
+#endif
+
 /**
  * @brief SSD1353 initialization function
  *
@@ -33,25 +62,20 @@
  * @param pinD7 Display pin D7
  */
 void SSD1353::init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF, uint8_t pinD0, uint8_t pinD1, uint8_t pinD2, uint8_t pinD3, uint8_t pinD4, uint8_t pinD5, uint8_t pinD6, uint8_t pinD7) {
-  _pinCS   = pinCS;
-  _pinDC   = pinDC;
-  _pinRS   = pinRS;
-  _pinDISF = pinDISF;
-  _pinD[0] = pinD0;
-  _pinD[1] = pinD1;
-  _pinD[2] = pinD2;
-  _pinD[3] = pinD3;
-  _pinD[4] = pinD4;
-  _pinD[5] = pinD5;
-  _pinD[6] = pinD6;
-  _pinD[7] = pinD7;
+  const uint8_t pinD[] = {pinD0, pinD1, pinD2, pinD3, pinD4, pinD5, pinD6, pinD7};
+  _pinCS               = pinCS;
+  _pinRS               = pinRS;
+  _pinDISF             = pinDISF;
 
   pinMode(_pinCS, OUTPUT);
-  pinMode(_pinDC, OUTPUT);
   pinMode(_pinRS, OUTPUT);
   pinMode(_pinDISF, OUTPUT);
-  for (uint8_t i = 0; i < 8; i++)
-    pinMode(_pinD[i], OUTPUT);
+  _bus.init(pinDC, pinD);
+
+#ifdef SSD1353_FAST_BUS
+  _regCS  = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(_pinCS));
+  _maskCS = digitalPinToBitMask(_pinCS);
+#endif
 
   // Display reset sequence
   digitalWrite(_pinDISF, LOW);
@@ -60,41 +84,388 @@ void SSD1353::init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF,
   digitalWrite(_pinRS, HIGH);
   delay(10);
 
-  // Turn display on
-  write(0xAF, true);
-  delay(200);
-  write(0xA0, true);
-  write(0xE0, false);
+  initSequence();
+  digitalWrite(_pinDISF, HIGH);
+}
+
+/**
+ * @brief Send the display setup sequence, called by init after reset
+ *
+ */
+void SSD1353Base::initSequence() {
+  uint8_t remap                 = 0x20 | _colorDepth;
+  static const uint8_t contrast = 0xFF;
+  static const uint8_t current  = 0x0F;
+
+  // The controller was reset, forget the fill setting sent before
+  _fillMode = 0xFF;
+
+  // Turn display on, the panel takes 200 ms to light up but accepts
+  // commands and RAM writes meanwhile
+  writeCommand(0xAF);
+  writeCommand(0xA0, &remap, 1);
 
   // Set contrast
-  write(0x81, true);
-  write(0xFF, false);
-  write(0x82, true);
-  write(0xFF, false);
-  write(0x83, true);
-  write(0xFF, false);
+  writeCommand(0x81, &contrast, 1);
+  writeCommand(0x82, &contrast, 1);
+  writeCommand(0x83, &contrast, 1);
 
   // Set master current
-  write(0x87, true);
-  write(0x0F, false);
+  writeCommand(0x87, &current, 1);
 
-  // Clear and then enable the display
+  // Clear the display
   clear();
-  digitalWrite(_pinDISF, HIGH);
+}
+
+/**
+ * @brief Note that commands reached this controller through another instance
+ *
+ * The cached fill setting can no longer be trusted, see SSD1353Group.
+ */
+void SSD1353Base::commandsShared() {
+  _fillMode = 0xFF;
+}
+
+/**
+ * @brief Note that another instance sent this controller a color depth
+ *
+ * @param colorDepth Color depth the controller is now in
+ */
+void SSD1353Base::colorDepthShared(uint8_t colorDepth) {
+  _colorDepth = colorDepth;
+}
+
+/**
+ * @brief Start a bus transaction
+ *
+ */
+void SSD1353Base::beginWrite() {
+  if (_writeDepth++ == 0 && !_queue)
+    busBegin();
+}
+
+/**
+ * @brief End a bus transaction
+ *
+ */
+void SSD1353Base::endWrite() {
+  if (--_writeDepth)
+    return;
+  if (_queue)
+    queueFinish();
+  else
+    busEnd();
+}
+
+/**
+ * @brief Send a command and its arguments as one transaction
+ *
+ * @param command Command byte
+ * @param args Pointer to the argument bytes
+ * @param length Number of argument bytes
+ */
+void SSD1353Base::writeCommand(uint8_t command, const uint8_t* args, uint8_t length) {
+  beginWrite();
+  sendBus(&command, 1, true);
+  if (length)
+    sendBus(args, length, false);
+  endWrite();
+}
+
+/**
+ * @brief Send a block of data bytes as one transaction
+ *
+ * @param data Pointer to the data bytes
+ * @param length Number of data bytes
+ */
+void SSD1353Base::writeData(const uint8_t* data, uint16_t length) {
+  beginWrite();
+  sendBus(data, length, false);
+  endWrite();
 }
 
 /**
  * @brief Write data to driver
  *
- * @param data Byte of data to be written
- * @param isCommand Byte is a command, true/false
+ * @param data Pointer to the bytes to be written
+ * @param length Number of bytes
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353::busWrite(const uint8_t* data, uint16_t length, bool isCommand) {
+  _bus.setCommand(isCommand);
+
+  // With WR tied low the rising edge of CS latches each byte
+  for (uint16_t n = 0; n < length; n++) {
+#ifdef SSD1353_FAST_BUS
+    *_regCS = *_regCS & ~_maskCS;
+    _bus.put(data[n]);
+    *_regCS = *_regCS | _maskCS;
+#else
+    digitalWrite(_pinCS, LOW);
+    _bus.put(data[n]);
+    digitalWrite(_pinCS, HIGH);
+#endif
+  }
+}
+
+/**
+ * @brief Set up the shared bus pins
+ *
+ * @param pinDC Display pin DC
+ * @param pinD Display pins D0-D7
  */
-void SSD1353::write(uint8_t data, bool isCommand) {
+void SSD1353ParallelBus::init(uint8_t pinDC, const uint8_t* pinD) {
+  _pinDC = pinDC;
+  memcpy(_pinD, pinD, sizeof(_pinD));
+
+  pinMode(_pinDC, OUTPUT);
+  for (uint8_t i = 0; i < 8; i++)
+    pinMode(_pinD[i], OUTPUT);
+
+#ifdef SSD1353_FAST_BUS
+  // Resolve the bus pins into output registers and bitmasks
+  _regDC  = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(_pinDC));
+  _maskDC = digitalPinToBitMask(_pinDC);
+
+  // Group the data lines by port
+  _busPorts = 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    SSD1353_PORT_REG reg = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(_pinD[i]));
+    uint8_t p = 0;
+    while (p < _busPorts && _busReg[p] != reg)
+      p++;
+    if (p == _busPorts) {
+      _busReg[p]  = reg;
+      _busMask[p] = 0;
+      _busPorts++;
+    }
+    _bitMask[i] = digitalPinToBitMask(_pinD[i]);
+    _bitPort[i] = p;
+    _busMask[p] |= _bitMask[i];
+  }
+
+  // Check for D0-D7 on consecutive bits of a single port
+  _busShift = 0xFF;
+  if (_busPorts == 1) {
+    uint8_t shift = 0;
+    while (shift < sizeof(SSD1353_PORT_T) * 8 - 8 && !((_bitMask[0] >> shift) & 1))
+      shift++;
+    bool contiguous = true;
+    for (uint8_t i = 0; i < 8; i++)
+      if (_bitMask[i] != ((SSD1353_PORT_T)1 << (shift + i)))
+        contiguous = false;
+    if (contiguous)
+      _busShift = shift;
+  }
+#endif
+}
+
+/**
+ * @brief Set the DC line for the bytes that follow
+ *
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353ParallelBus::setCommand(bool isCommand) {
+#ifdef SSD1353_FAST_BUS
+  if (isCommand)
+    *_regDC = *_regDC & ~_maskDC;
+  else
+    *_regDC = *_regDC | _maskDC;
+#else
   digitalWrite(_pinDC, !isCommand);
-  digitalWrite(_pinCS, LOW);
+#endif
+}
+
+/**
+ * @brief Put a byte on D0-D7, latched by the next rising CS edge
+ *
+ * @param data Byte to put on the bus
+ */
+void SSD1353ParallelBus::put(uint8_t data) {
+#ifdef SSD1353_FAST_BUS
+  if (_busShift != 0xFF) {
+    // D0-D7 are contiguous on one port, write the whole byte at once
+    *_busReg[0] = (*_busReg[0] & ~_busMask[0]) | ((SSD1353_PORT_T)data << _busShift);
+  } else {
+    SSD1353_PORT_T set[8] = {0};
+    for (uint8_t i = 0; i < 8; i++)
+      if ((data >> i) & 1)
+        set[_bitPort[i]] |= _bitMask[i];
+    for (uint8_t p = 0; p < _busPorts; p++)
+      *_busReg[p] = (*_busReg[p] & ~_busMask[p]) | set[p];
+  }
+#else
   for (uint8_t i = 0; i < 8; i++)
     digitalWrite(_pinD[i], ((data >> i) & 1));
-  digitalWrite(_pinCS, HIGH);
+#endif
+}
+
+/**
+ * @brief Calibrate the drawing engine completion time model
+ *
+ * A rectangle is taken to finish baseMicros plus nanosPerPixel for every
+ * pixel it writes after its last byte was sent. Lines only pay the per pixel
+ * time, they never needed a wait before.
+ *
+ * @param baseMicros Fixed time per command in microseconds
+ * @param nanosPerPixel Time per written pixel in nanoseconds
+ */
+void SSD1353Base::setAccelTiming(uint16_t baseMicros, uint16_t nanosPerPixel) {
+  _accelBase  = baseMicros;
+  _accelNanos = nanosPerPixel;
+}
+
+/**
+ * @brief Check if the drawing engine is still working
+ *
+ * @return Drawing engine busy, true/false
+ */
+bool SSD1353Base::busy() {
+  QueueLock lock;
+  return engineBusy();
+}
+
+/**
+ * @brief busy() for callers already safe from poll() in an interrupt
+ *
+ * @return Drawing engine busy, true/false
+ */
+bool SSD1353Base::engineBusy() {
+  if (_accelBusy && (int32_t)(micros() - _accelUntil) >= 0)
+    _accelBusy = false;
+  return _accelBusy;
+}
+
+/**
+ * @brief Wait until the drawing engine has finished
+ *
+ * Anything that needs the engine or display RAM waits first, so CPU work
+ * and register writes done in between overlap the engine for free. With
+ * the asynchronous queue on, everything queued is sent first.
+ */
+void SSD1353Base::waitIdle() {
+  if (_queue) {
+    while (queued())
+      drain(0xFFFF, true);
+    queueFinish();
+  }
+  waitEngine();
+}
+
+/**
+ * @brief Sleep until the current engine timer runs out
+ *
+ */
+void SSD1353Base::waitEngine() {
+  if (!_accelBusy)
+    return;
+
+  uint32_t left = _accelUntil - micros();
+  if ((int32_t)left > 0) {
+    SSD1353_STAT(_stats.waitMicros += left);
+
+    // delayMicroseconds is only accurate up to 16383 us on AVR
+    while (left > 16383) {
+      delayMicroseconds(16383);
+      left -= 16383;
+    }
+    delayMicroseconds(left);
+  }
+  _accelBusy = false;
+}
+
+/**
+ * @brief Start the completion timer for an accelerated command
+ *
+ * @param baseMicros Fixed time of the command in microseconds
+ * @param pixels Number of pixels the command writes
+ */
+void SSD1353Base::startAccel(uint16_t baseMicros, uint32_t pixels) {
+  uint32_t duration = baseMicros + pixels * _accelNanos / 1000;
+  if (_queue) {
+    // The timer starts when the command actually leaves the queue
+    queueMarker(SSD1353_QUEUE_ACCEL, duration > 0xFFFF ? 0xFFFF : duration);
+    return;
+  }
+  _accelUntil = micros() + duration;
+  _accelBusy  = true;
+}
+
+/**
+ * @brief Wait for the drawing engine before a command that needs it
+ *
+ * With the asynchronous queue on, the wait is queued instead.
+ */
+void SSD1353Base::needEngine() {
+  if (_queue)
+    queueMarker(SSD1353_QUEUE_WAIT);
+  else
+    waitIdle();
+}
+
+/**
+ * @brief Select the pixel format of display RAM writes
+ *
+ * In 65k color mode every pixel takes two bus bytes instead of three, the
+ * drawing commands keep their 6-bit color values.
+ *
+ * @param depth Acceptable values: SSD1353_COLOR_65K, SSD1353_COLOR_262K
+ */
+void SSD1353Base::setColorDepth(uint8_t depth) {
+  if (depth != SSD1353_COLOR_65K && depth != SSD1353_COLOR_262K)
+    return;
+
+  uint8_t remap = 0x20 | depth;
+  _colorDepth   = depth;
+  writeCommand(0xA0, &remap, 1);
+}
+
+/**
+ * @brief Load a grayscale table into the controller
+ *
+ * The table maps the 63 nonzero gray levels of each channel to drive pulse
+ * widths, so a gamma curve set here applies to every pixel for free.
+ * Ready-made tables are in SSD1353Gamma.h.
+ *
+ * @param table SSD1353_GAMMA_ENTRIES rising pulse widths in PROGMEM
+ */
+void SSD1353Base::setGammaTable(const uint8_t* table) {
+  uint8_t widths[SSD1353_GAMMA_ENTRIES];
+  for (uint8_t i = 0; i < SSD1353_GAMMA_ENTRIES; i++)
+    widths[i] = pgm_read_byte(table + i);
+  writeCommand(0xB8, widths, SSD1353_GAMMA_ENTRIES);
+}
+
+/**
+ * @brief Return to the controller's built-in linear grayscale table
+ *
+ */
+void SSD1353Base::resetGammaTable() {
+  writeCommand(0xB9);
+}
+
+/**
+ * @brief Convert 6-bit channel values to the bytes of one RAM pixel
+ *
+ * Blue goes first in both formats. In 65k color mode the pixel is blue,
+ * green and red in 5, 6 and 5 bits, high byte first.
+ *
+ * @param out Buffer for up to 3 bytes
+ * @param red Red color value
+ * @param green Green color value
+ * @param blue Blue color value
+ * @return Number of bytes in the pixel
+ */
+uint8_t SSD1353Base::packPixel(uint8_t* out, uint8_t red, uint8_t green, uint8_t blue) const {
+  if (_colorDepth == SSD1353_COLOR_65K) {
+    out[0] = ((blue >> 1) << 3) | (green >> 3);
+    out[1] = (green << 5) | (red >> 1);
+    return 2;
+  }
+  out[0] = blue;
+  out[1] = green;
+  out[2] = red;
+  return 3;
 }
 
 /**
@@ -102,19 +473,25 @@ void SSD1353::write(uint8_t data, bool isCommand) {
  *
  * @param mode Acceptable values: SSD1353_OFF, SSD1353_ON, SSD1353_INVERSE
  */
-void SSD1353::displayMode(uint8_t mode) {
+void SSD1353Base::displayMode(uint8_t mode) {
   if (mode == SSD1353_OFF || mode == SSD1353_ON || mode == SSD1353_INVERSE)
-    write(mode, true);
+    writeCommand(mode);
 }
 
 /**
  * @brief Enable/disable rectangle fill on drawRectangle
  *
+ * The command is only sent when the setting changes.
+ *
  * @param enable Enable rectangle fill, true/false
  */
-void SSD1353::enableFill(bool enable) {
-  write(0x26, true);
-  write(0 + enable, false);
+void SSD1353Base::enableFill(bool enable) {
+  uint8_t mode = enable;
+  if (mode == _fillMode)
+    return;
+
+  writeCommand(0x26, &mode, 1);
+  _fillMode = mode;
 }
 
 /**
@@ -132,21 +509,68 @@ void SSD1353::enableFill(bool enable) {
  * @param fillBlue Rectangle fill blue color value
  * @param useFill Fill the rectangle, true/false
  */
-void SSD1353::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+void SSD1353Base::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  SSD1353Rect rect    = {min(startX, endX), min(startY, endY), max(startX, endX), max(startY, endY)};
+  SSD1353Rect visible = rect;
+  SSD1353_STAT(bool whole = useFill && !rect.x0 && !rect.y0 && rect.x1 == SSD1353_WIDTH - 1 && rect.y1 == SSD1353_HEIGHT - 1);
+  SSD1353_STAT(StatScope scope(*this, whole ? SSD1353_STAT_FILL : SSD1353_STAT_RECTANGLE));
+  if (!clipRect(visible))
+    return;
+
+  if (visible.x0 == rect.x0 && visible.y0 == rect.y0 && visible.x1 == rect.x1 && visible.y1 == rect.y1) {
+    rectangleCommand(rect, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+    return;
+  }
+
+  // Cut by the clip: fill what is visible, then draw the border sides still in view
+  beginWrite();
+  if (useFill)
+    rectangleCommand(visible, fillRed, fillGreen, fillBlue, fillRed, fillGreen, fillBlue, true);
+  if (visible.y0 == rect.y0)
+    drawLine(visible.x0, rect.y0, visible.x1, rect.y0, lineRed, lineGreen, lineBlue);
+  if (visible.y1 == rect.y1)
+    drawLine(visible.x0, rect.y1, visible.x1, rect.y1, lineRed, lineGreen, lineBlue);
+  if (visible.x0 == rect.x0)
+    drawLine(rect.x0, visible.y0, rect.x0, visible.y1, lineRed, lineGreen, lineBlue);
+  if (visible.x1 == rect.x1)
+    drawLine(rect.x1, visible.y0, rect.x1, visible.y1, lineRed, lineGreen, lineBlue);
+  endWrite();
+}
+
+/**
+ * @brief Send a rectangle command, no clipping
+ *
+ * @param rect Rectangle in display coordinates
+ * @param lineRed Border line red color value
+ * @param lineGreen Border line green color value
+ * @param lineBlue Border line blue color value
+ * @param fillRed Rectangle fill red color value
+ * @param fillGreen Rectangle fill green color value
+ * @param fillBlue Rectangle fill blue color value
+ * @param useFill Fill the rectangle, true/false
+ */
+void SSD1353Base::rectangleCommand(const SSD1353Rect& rect, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  beginWrite();
+  needEngine();
   enableFill(useFill);
+  SSD1353_STAT(_stats.fills += useFill);
 
-  write(0x22, true);
-  write(startX, false);
-  write(startY, false);
-  write(endX, false);
-  write(endY, false);
-  write(lineBlue, false);
-  write(lineGreen, false);
-  write(lineRed, false);
-  write(fillBlue, false);
-  write(fillGreen, false);
-  write(fillRed, false);
-  delay(2);
+  uint8_t args[] = {rect.x0, rect.y0, rect.x1, rect.y1, lineBlue, lineGreen, lineRed, fillBlue, fillGreen, fillRed};
+  writeCommand(0x22, args, sizeof(args));
+
+  uint16_t width  = rect.x1 - rect.x0 + 1;
+  uint16_t height = rect.y1 - rect.y0 + 1;
+  startAccel(_accelBase, useFill ? (uint32_t)width * height : 2 * (width + height));
+  endWrite();
+}
+
+// Division rounded to the nearest integer, halves away from zero
+static int16_t roundDiv(int32_t numerator, int32_t denominator) {
+  if (denominator < 0) {
+    numerator   = -numerator;
+    denominator = -denominator;
+  }
+  return numerator < 0 ? -((-numerator + denominator / 2) / denominator) : (numerator + denominator / 2) / denominator;
 }
 
 /**
@@ -160,15 +584,269 @@ void SSD1353::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_
  * @param lineGreen Line green color  value
  * @param lineBlue Line blue color value
  */
-void SSD1353::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) {
-  write(0x21, true);
-  write(startX, false);
-  write(startY, false);
-  write(endX, false);
-  write(endY, false);
-  write(lineBlue, false);
-  write(lineGreen, false);
-  write(lineRed, false);
+void SSD1353Base::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) {
+  SSD1353_STAT(StatScope scope(*this, SSD1353_STAT_LINE));
+
+  // Cohen-Sutherland: move an outside end onto the clip edge it is beyond
+  // until both ends are inside, or both are beyond the same edge
+  const SSD1353Rect& area = clip();
+  int16_t x[]             = {startX, endX};
+  int16_t y[]             = {startY, endY};
+  for (;;) {
+    uint8_t code[2];
+    for (uint8_t n = 0; n < 2; n++)
+      code[n] = (x[n] < area.x0) | (x[n] > area.x1) << 1 | (y[n] < area.y0) << 2 | (y[n] > area.y1) << 3;
+    if (!(code[0] | code[1]))
+      break;
+    if (code[0] & code[1])
+      return;
+
+    uint8_t n  = code[0] ? 0 : 1;
+    int16_t dx = x[1 - n] - x[n];
+    int16_t dy = y[1 - n] - y[n];
+    if (code[n] & 0x03) {
+      int16_t edge = code[n] & 0x01 ? area.x0 : area.x1;
+      y[n] += roundDiv((int32_t)dy * (edge - x[n]), dx);
+      x[n] = edge;
+    } else {
+      int16_t edge = code[n] & 0x04 ? area.y0 : area.y1;
+      x[n] += roundDiv((int32_t)dx * (edge - y[n]), dy);
+      y[n] = edge;
+    }
+  }
+
+  beginWrite();
+  needEngine();
+
+  uint8_t args[] = {(uint8_t)x[0], (uint8_t)y[0], (uint8_t)x[1], (uint8_t)y[1], lineBlue, lineGreen, lineRed};
+  writeCommand(0x21, args, sizeof(args));
+
+  uint8_t width  = x[0] < x[1] ? x[1] - x[0] : x[0] - x[1];
+  uint8_t height = y[0] < y[1] ? y[1] - y[0] : y[0] - y[1];
+  startAccel(0, (width > height ? width : height) + 1);
+  endWrite();
+}
+
+/**
+ * @brief Limit drawing to a rectangle
+ *
+ * The rectangle is cut to the current clip and pushed on a stack, drawing
+ * outside it costs no bus traffic. Undo with popClip().
+ *
+ * @param startX Bottom left corner X coordinate
+ * @param startY Bottom left corner Y coordinate
+ * @param endX Top right corner X coordinate
+ * @param endY Top right corner Y coordinate
+ * @return true on success, false if SSD1353_CLIP_DEPTH clips are already pushed
+ */
+bool SSD1353Base::pushClip(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY) {
+#if SSD1353_CLIP_DEPTH
+  if (_clipDepth == SSD1353_CLIP_DEPTH)
+    return false;
+
+  SSD1353Rect rect = {min(startX, endX), min(startY, endY), max(startX, endX), max(startY, endY)};
+  if (!clipRect(rect))
+    rect = {1, 0, 0, 0};
+  _clip[++_clipDepth] = rect;
+  return true;
+#else
+  (void)startX;
+  (void)startY;
+  (void)endX;
+  (void)endY;
+  return false;
+#endif
+}
+
+/**
+ * @brief Restore the clip rectangle in use before the last pushClip()
+ *
+ */
+void SSD1353Base::popClip() {
+#if SSD1353_CLIP_DEPTH
+  if (_clipDepth)
+    _clipDepth--;
+#endif
+}
+
+/**
+ * @brief Cut a rectangle to the current clip
+ *
+ * @param rect Rectangle with x0 <= x1 and y0 <= y1, changed in place
+ * @return false if nothing of it is left
+ */
+bool SSD1353Base::clipRect(SSD1353Rect& rect) const {
+  const SSD1353Rect& area = clip();
+  rect.x0                 = max(rect.x0, area.x0);
+  rect.y0                 = max(rect.y0, area.y0);
+  rect.x1                 = min(rect.x1, area.x1);
+  rect.y1                 = min(rect.y1, area.y1);
+  return rect.x0 <= rect.x1 && rect.y0 <= rect.y1;
+}
+
+/**
+ * @brief Copy an area of the display to another place
+ *
+ * The copy is done by the drawing engine. The datasheet does not say how
+ * an overlapping source and destination are handled, keep them apart.
+ *
+ * @param startX Source first corner X coordinate
+ * @param startY Source first corner Y coordinate
+ * @param endX Source opposite corner X coordinate
+ * @param endY Source opposite corner Y coordinate
+ * @param newX Destination bottom left corner X coordinate
+ * @param newY Destination bottom left corner Y coordinate
+ */
+void SSD1353Base::copyArea(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t newX, uint8_t newY) {
+  SSD1353Rect source = {min(startX, endX), min(startY, endY), max(startX, endX), max(startY, endY)};
+
+  // Only the destination is clipped, the source shrinks with it
+  SSD1353Rect target = {newX, newY, (uint8_t)min(newX + source.x1 - source.x0, 0xFF), (uint8_t)min(newY + source.y1 - source.y0, 0xFF)};
+  if (!clipRect(target))
+    return;
+  startX = source.x0 + target.x0 - newX;
+  startY = source.y0 + target.y0 - newY;
+
+  beginWrite();
+  needEngine();
+
+  uint8_t args[] = {startX, startY, (uint8_t)(startX + target.x1 - target.x0), (uint8_t)(startY + target.y1 - target.y0), target.x0, target.y0};
+  writeCommand(0x23, args, sizeof(args));
+
+  // Every pixel is read and written once
+  startAccel(_accelBase, 2 * (uint32_t)(target.x1 - target.x0 + 1) * (target.y1 - target.y0 + 1));
+  endWrite();
+}
+
+/**
+ * @brief Start the controller's continuous scrolling
+ *
+ * The rows from startY up wrap around horizontally, the whole display
+ * wraps around vertically. The panel keeps moving on its own, no bus
+ * traffic is needed until the scroll is stopped. The controller does not
+ * support drawing while it scrolls, call stopScroll() first.
+ *
+ * @param startY First row that scrolls horizontally
+ * @param rows Number of rows that scroll horizontally
+ * @param horizontal Columns moved per step, negative values move the other way
+ * @param vertical Rows moved per step, negative values move the other way
+ * @param interval Frames per step, SSD1353_SCROLL_6_FRAMES to SSD1353_SCROLL_200_FRAMES
+ */
+void SSD1353Base::startScroll(uint8_t startY, uint8_t rows, int8_t horizontal, int8_t vertical, uint8_t interval) {
+  uint8_t args[] = {(uint8_t)(horizontal < 0 ? SSD1353_WIDTH + horizontal : horizontal), startY, rows,
+                    (uint8_t)(vertical < 0 ? SSD1353_HEIGHT + vertical : vertical), interval};
+
+  beginWrite();
+  needEngine();
+  if (_scrolling)
+    writeCommand(0x2E);
+  writeCommand(0x27, args, sizeof(args));
+  writeCommand(0x2F);
+  endWrite();
+  _scrolling = true;
+}
+
+/**
+ * @brief Stop the continuous scrolling
+ *
+ * The scrolled area has to be redrawn after this.
+ */
+void SSD1353Base::stopScroll() {
+  if (!_scrolling)
+    return;
+
+  writeCommand(0x2E);
+  _scrolling = false;
+}
+
+/**
+ * @brief Set the display RAM window and start a RAM write
+ *
+ * Pixels written after this fill the window row by row, starting from
+ * (startX, startY) and increasing X first. Waits for the drawing engine,
+ * which shares the display RAM.
+ *
+ * @param startX Window left column
+ * @param startY Window bottom row
+ * @param endX Window right column
+ * @param endY Window top row
+ */
+void SSD1353Base::setWindow(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY) {
+  uint8_t columns[] = {startX, endX};
+  uint8_t rows[]    = {startY, endY};
+
+  beginWrite();
+  needEngine();
+  writeCommand(0x15, columns, 2);
+  writeCommand(0x75, rows, 2);
+  writeCommand(0x5C);
+  endWrite();
+}
+
+/**
+ * @brief Stream RGB565 pixels into the current RAM window
+ *
+ * @param pixels Pointer to the pixels
+ * @param count Number of pixels
+ */
+void SSD1353Base::writePixels(const uint16_t* pixels, uint16_t count) {
+  uint8_t buff[48];
+  uint8_t size = _colorDepth == SSD1353_COLOR_65K ? 2 : 3;
+
+  beginWrite();
+  while (count) {
+    uint8_t n = count < sizeof(buff) / size ? count : sizeof(buff) / size;
+    if (size == 2) {
+      // Red and blue trade places, blue goes first
+      for (uint8_t i = 0; i < n; i++) {
+        uint16_t pixel  = pixels[i];
+        buff[i * 2]     = ((pixel & 0x1F) << 3) | ((pixel >> 8) & 0x07);
+        buff[i * 2 + 1] = (pixel & 0xE0) | (pixel >> 11);
+      }
+    } else {
+      for (uint8_t i = 0; i < n; i++) {
+        uint16_t pixel  = pixels[i];
+        uint8_t red     = pixel >> 11;
+        uint8_t blue    = pixel & 0x1F;
+        buff[i * 3]     = (blue << 1) | (blue >> 4);
+        buff[i * 3 + 1] = (pixel >> 5) & 0x3F;
+        buff[i * 3 + 2] = (red << 1) | (red >> 4);
+      }
+    }
+    writeData(buff, n * size);
+    pixels += n;
+    count -= n;
+  }
+  endWrite();
+}
+
+/**
+ * @brief Draw a block of RGB565 pixels on the display
+ *
+ * @param x Bitmap bottom left corner X coordinate
+ * @param y Bitmap bottom left corner Y coordinate
+ * @param width Bitmap width
+ * @param height Bitmap height
+ * @param pixels Pointer to width * height pixels, bottom row first
+ */
+void SSD1353Base::drawBitmap(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint16_t* pixels) {
+  if (!width || !height)
+    return;
+
+  SSD1353Rect visible = {x, y, (uint8_t)min(x + width - 1, 0xFF), (uint8_t)min(y + height - 1, 0xFF)};
+  if (!clipRect(visible))
+    return;
+
+  beginWrite();
+  setWindow(visible.x0, visible.y0, visible.x1, visible.y1);
+  if (visible.x0 == x && visible.x1 == x + width - 1) {
+    writePixels(pixels + (uint16_t)(visible.y0 - y) * width, (uint16_t)width * (visible.y1 - visible.y0 + 1));
+  } else {
+    // Clipped at the sides, send the visible part of each row
+    for (uint8_t j = visible.y0; j <= visible.y1; j++)
+      writePixels(pixels + (uint16_t)(j - y) * width + (visible.x0 - x), visible.x1 - visible.x0 + 1);
+  }
+  endWrite();
 }
 
 /**
@@ -180,7 +858,7 @@ void SSD1353::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t end
  * @param valueGreen Dot green color value
  * @param valueBlue Dot blue color value
  */
-void SSD1353::drawDot(uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+void SSD1353Gfx::drawDot(uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
   drawLine(x, y, x, y, valueRed, valueGreen, valueBlue);
 }
 
@@ -191,7 +869,7 @@ void SSD1353::drawDot(uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen
  * @param valueGreen Fill color green value
  * @param valueBlue Fill color blue value
  */
-void SSD1353::fill(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+void SSD1353Gfx::fill(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
   drawRectangle(0, 0, 159, 127, valueRed, valueGreen, valueBlue, valueRed, valueGreen, valueBlue, true);
 }
 
@@ -199,13 +877,29 @@ void SSD1353::fill(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
  * @brief Clear the screen contents
  *
  */
-void SSD1353::clear() {
+void SSD1353Gfx::clear() {
   fill(0, 0, 0);
 }
 
+/**
+ * @brief Read the column bitmaps of a character's glyph
+ *
+ * @param character Character to look up
+ * @param columns Buffer for SSD1353_FONT_WIDTH column bytes, bit 0 is the bottom row
+ */
+static void readGlyph(char character, uint8_t* columns) {
+  uint16_t offset = ssd1353Glyph(character);
+  for (uint8_t i = 0; i < SSD1353_FONT_WIDTH; i++)
+    columns[i] = pgm_read_byte(ssd1353Font + offset + i);
+}
+
 /**
  * @brief Print a character on the display
  *
+ * The glyph is drawn with the minimal set of horizontal and vertical
+ * lines precomputed in SSD1353Strokes.h. Pixels around the glyph are left
+ * untouched.
+ *
  * @param x Character bottom left corner X coordinate
  * @param y Character bottom left corner Y coordinate
  * @param character Character to  be printed
@@ -213,655 +907,124 @@ void SSD1353::clear() {
  * @param valueGreen Character green color value
  * @param valueBlue Character blue color value
  */
-void SSD1353::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
-  switch (character) {
-    case 'A':
-      drawLine(x, y, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'B':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'C':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'D':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'E':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'F':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'G':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'H':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'I':
-      drawLine(x + 2, y, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'J':
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y + 1, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'K':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 5, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'L':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'M':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 3, x + 2, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'N':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'O':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'P':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'Q':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'R':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'S':
-      drawLine(x, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'T':
-      drawLine(x + 2, y, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'U':
-      drawLine(x, y + 1, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'V':
-      drawLine(x, y + 2, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 1, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 2, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'W':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'X':
-      drawLine(x, y, x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 5, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 5, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'Y':
-      drawLine(x, y + 5, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 5, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'Z':
-      drawLine(x, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'a':
-      drawLine(x, y + 1, x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'b':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'c':
-      drawLine(x, y + 1, x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'd':
-      drawLine(x, y + 1, x, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'e':
-      drawLine(x, y + 1, x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'f':
-      drawLine(x + 1, y, x + 1, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 3, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'g':
-      drawDot(x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'h':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'i':
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'j':
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 2, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y + 1, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'k':
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'l':
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'm':
-      drawLine(x, y, x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'n':
-      drawLine(x, y, x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'o':
-      drawLine(x, y + 1, x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'p':
-      drawLine(x + 1, y, x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'q':
-      drawLine(x + 3, y, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 2, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'r':
-      drawLine(x, y, x, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 4, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 's':
-      drawLine(x, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 't':
-      drawLine(x + 2, y + 1, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'u':
-      drawLine(x, y + 1, x, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'v':
-      drawLine(x, y + 2, x, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 1, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 2, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'w':
-      drawLine(x, y, x, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'x':
-      drawDot(x, y, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 1, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'y':
-      drawLine(x, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 3, x, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case 'z':
-      drawLine(x, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 1, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '0':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '1':
-      drawLine(x, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '2':
-      drawLine(x, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '3':
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '4':
-      drawLine(x, y + 2, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '5':
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '6':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '7':
-      drawLine(x, y + 6, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '8':
-      drawLine(x, y + 1, x, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 4, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '9':
-      drawDot(x, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '&':
-      drawLine(x, y + 1, x, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 2, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 4, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 4, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '\'':
-      drawLine(x + 2, y + 5, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '(':
-      drawLine(x + 2, y + 1, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case ')':
-      drawDot(x + 1, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '*':
-      drawLine(x, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 3, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 5, x + 4, y + 1, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '+':
-      drawLine(x, y + 3, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '-':
-      drawLine(x, y + 3, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '=':
-      drawLine(x, y + 2, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '.':
-      drawDot(x + 2, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '!':
-      drawDot(x + 2, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '"':
-      drawLine(x + 1, y + 5, x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y + 5, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '#':
-      drawLine(x, y + 2, x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x, y + 4, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '$':
-      drawLine(x, y + 1, x + 3, y + 1, valueRed, valueGreen, valueBlue);
-      drawDot(x, y + 4, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 5, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '%':
-      drawLine(x, y + 1, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      drawRectangle(x, y + 5, x + 1, y + 6, valueRed, valueGreen, valueBlue, valueRed, valueGreen, valueBlue, false);
-      drawRectangle(x + 3, y, x + 4, y + 1, valueRed, valueGreen, valueBlue, valueRed, valueGreen, valueBlue, false);
-      break;
-
-    case '^':
-      drawLine(x, y + 4, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 3, y + 5, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case ',':
-      drawDot(x + 1, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 1, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      break;
-
-    case ':':
-      drawLine(x + 2, y + 1, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 4, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case ';':
-      drawLine(x + 2, y + 1, x + 2, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 4, x + 2, y + 5, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '?':
-      drawDot(x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 2, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 4, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '@':
-      drawLine(x, y + 1, x, y + 5, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y + 2, x + 2, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y + 3, x + 4, y + 5, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '/':
-      drawLine(x, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '<':
-      drawLine(x, y + 3, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 2, x + 3, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '>':
-      drawLine(x + 1, y, x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 4, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '|':
-      drawLine(x + 2, y, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '\\':
-      drawLine(x, y + 6, x + 4, y, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '[':
-      drawLine(x + 2, y, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case ']':
-      drawDot(x + 1, y, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 2, y, x + 2, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-
-    case '{':
-      drawLine(x + 1, y + 3, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 3, x + 3, y, valueRed, valueGreen, valueBlue);
-      break;
+void SSD1353Gfx::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+  uint8_t columns[SSD1353_FONT_WIDTH];
+  readGlyph(character, columns);
+
+  uint16_t glyph = ssd1353Glyph(character) / SSD1353_FONT_WIDTH;
+  uint16_t first = pgm_read_word(&ssd1353StrokeIndex.data[glyph]);
+  uint16_t last  = pgm_read_word(&ssd1353StrokeIndex.data[glyph + 1]);
+
+  for (uint16_t n = first; n < last; n++) {
+    uint8_t stroke = pgm_read_byte(&ssd1353Strokes.data[n]);
+    uint8_t i      = (stroke & ~SSD1353_STROKE_VERTICAL) / 7;
+    uint8_t j      = (stroke & ~SSD1353_STROKE_VERTICAL) % 7;
+    uint8_t end;
+
+    // Strokes are maximal runs, follow the glyph to find where they end
+    if (stroke & SSD1353_STROKE_VERTICAL) {
+      for (end = j; end + 1 < SSD1353_FONT_HEIGHT && ((columns[i] >> (end + 1)) & 1); end++)
+        ;
+      drawLine(x + i, y + j, x + i, y + end, valueRed, valueGreen, valueBlue);
+    } else {
+      for (end = i; end + 1 < SSD1353_FONT_WIDTH && ((columns[end + 1] >> j) & 1); end++)
+        ;
+      drawLine(x + i, y + j, x + end, y + j, valueRed, valueGreen, valueBlue);
+    }
+  }
+}
 
-    case '}':
-      drawLine(x + 1, y, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 3, valueRed, valueGreen, valueBlue);
-      break;
+/**
+ * @brief Print a character with a background on the display
+ *
+ * Fills the 6x8 character cell with the background color and then draws
+ * the glyph on top.
+ *
+ * @param x Character bottom left corner X coordinate
+ * @param y Character bottom left corner Y coordinate
+ * @param character Character to  be printed
+ * @param valueRed Character red color value
+ * @param valueGreen Character green color value
+ * @param valueBlue Character blue color value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Gfx::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  drawRectangle(x, y, x + SSD1353_FONT_WIDTH, y + SSD1353_FONT_HEIGHT, backgroundRed, backgroundGreen, backgroundBlue, backgroundRed, backgroundGreen, backgroundBlue, true);
+  printchar(x, y, character, valueRed, valueGreen, valueBlue);
+}
 
-    case '_':
-      drawLine(x, y, x + 4, y, valueRed, valueGreen, valueBlue);
-      break;
+/**
+ * @brief Print a character with a background on the display
+ *
+ * The whole 6x8 character cell, glyph and background, is sent as a
+ * single RAM window write.
+ *
+ * @param x Character bottom left corner X coordinate
+ * @param y Character bottom left corner Y coordinate
+ * @param character Character to  be printed
+ * @param valueRed Character red color value
+ * @param valueGreen Character green color value
+ * @param valueBlue Character blue color value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Base::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  SSD1353_STAT(StatScope scope(*this, SSD1353_STAT_CHAR));
+
+  // Only the part of the cell inside the clip is sent
+  SSD1353Rect cell = {x, y, (uint8_t)min(x + SSD1353_FONT_WIDTH, 0xFF), (uint8_t)min(y + SSD1353_FONT_HEIGHT, 0xFF)};
+  if (!clipRect(cell))
+    return;
+
+  uint8_t columns[SSD1353_FONT_WIDTH + 1] = {0};
+  readGlyph(character, columns);
+
+  uint8_t width  = cell.x1 - cell.x0 + 1;
+  uint8_t height = cell.y1 - cell.y0 + 1;
+  uint8_t skipX  = cell.x0 - x;
+  uint8_t skipY  = cell.y0 - y;
+  uint8_t row[(SSD1353_FONT_WIDTH + 1) * 3];
+  uint8_t value[3],
+      background[3];
+  uint8_t size = packPixel(value, valueRed, valueGreen, valueBlue);
+  packPixel(background, backgroundRed, backgroundGreen, backgroundBlue);
+
+  beginWrite();
+  setWindow(cell.x0, cell.y0, cell.x1, cell.y1);
+  for (uint8_t j = 0; j < height; j++) {
+    for (uint8_t i = 0; i < width; i++)
+      memcpy(row + i * size, (columns[i + skipX] >> (j + skipY)) & 1 ? value : background, size);
+    writeData(row, width * size);
+  }
+  endWrite();
+}
 
-    case '~':
-      drawDot(x, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 1, y + 4, valueRed, valueGreen, valueBlue);
-      drawDot(x + 2, y + 3, valueRed, valueGreen, valueBlue);
-      drawDot(x + 3, y + 2, valueRed, valueGreen, valueBlue);
-      drawDot(x + 4, y + 3, valueRed, valueGreen, valueBlue);
-      break;
+/**
+ * @brief Print a character with a transparent background
+ *
+ * Characters entirely outside the clip are dropped before their strokes
+ * are looked up.
+ *
+ * @param x Location X coordinate
+ * @param y Location Y coordinate
+ * @param character Character to print
+ * @param valueRed Character red color value
+ * @param valueGreen Character green color value
+ * @param valueBlue Character blue color value
+ */
+void SSD1353Base::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+  SSD1353_STAT(StatScope scope(*this, SSD1353_STAT_CHAR));
 
-    case ' ':
-      break;
+  SSD1353Rect cell = {x, y, (uint8_t)min(x + SSD1353_FONT_WIDTH - 1, 0xFF), (uint8_t)min(y + SSD1353_FONT_HEIGHT - 1, 0xFF)};
+  if (!clipRect(cell))
+    return;
 
-    default:
-      drawLine(x, y, x, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y, x + 3, y, valueRed, valueGreen, valueBlue);
-      drawLine(x + 1, y + 6, x + 3, y + 6, valueRed, valueGreen, valueBlue);
-      drawLine(x + 4, y, x + 4, y + 6, valueRed, valueGreen, valueBlue);
-      break;
-  }
+  beginWrite();
+  SSD1353Gfx::printchar(x, y, character, valueRed, valueGreen, valueBlue);
+  endWrite();
 }
 
 /**
@@ -874,8 +1037,26 @@ void SSD1353::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed,
  * @param valueGreen String color green value
  * @param valueBlue String color blue value
  */
-void SSD1353::printstr(const char* input, uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
-  for (uint8_t i = 0; i < strlen(input); i++) {
-    printchar((x + i * 6), y, input[i], valueRed, valueGreen, valueBlue);
-  }
+void SSD1353Gfx::printstr(const char* input, uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+  // Stop at the right edge instead of wrapping around through uint8_t
+  for (uint16_t cursor = x; *input && cursor < SSD1353_WIDTH; cursor += 6)
+    printchar(cursor, y, *input++, valueRed, valueGreen, valueBlue);
+}
+
+/**
+ * @brief Print a string with a background on the display
+ *
+ * @param input String to be printed
+ * @param x String bottom left corner X coordinate
+ * @param y String bottom left corner Y coordinate
+ * @param valueRed String color red value
+ * @param valueGreen String color green value
+ * @param valueBlue String color blue value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Gfx::printstr(const char* input, uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  for (uint16_t cursor = x; *input && cursor < SSD1353_WIDTH; cursor += 6)
+    printchar(cursor, y, *input++, valueRed, valueGreen, valueBlue, backgroundRed, backgroundGreen, backgroundBlue);
 }
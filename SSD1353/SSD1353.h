@@ -16,33 +16,422 @@
 #ifndef SSD1353_H
 #define SSD1353_H
 
+#include <Arduino.h>
 #include <stdint.h>
 
 #define SSD1353_OFF     0xA6
 #define SSD1353_ON      0xA4
 #define SSD1353_INVERSE 0xA7
 
-class SSD1353 {
+// Continuous scroll step intervals
+#define SSD1353_SCROLL_6_FRAMES   0x00
+#define SSD1353_SCROLL_10_FRAMES  0x01
+#define SSD1353_SCROLL_100_FRAMES 0x02
+#define SSD1353_SCROLL_200_FRAMES 0x03
+
+#define SSD1353_WIDTH  160
+#define SSD1353_HEIGHT 128
+
+// Drawing engine completion time model: a fixed start-up time plus a time
+// per pixel the engine writes. The defaults give a full screen fill the 2 ms
+// the driver used to wait after every rectangle.
+#ifndef SSD1353_ACCEL_BASE_US
+#define SSD1353_ACCEL_BASE_US 40
+#endif
+
+#ifndef SSD1353_ACCEL_NS_PER_PIXEL
+#define SSD1353_ACCEL_NS_PER_PIXEL 96
+#endif
+
+// Counters of bus traffic and time per primitive, off unless defined for
+// the whole build (or uncommented here); off, the counting compiles away.
+// The counters change the layout of SSD1353Base, so the define must reach
+// every source file, the library's included: set it in the compiler flags,
+// not with a #define in a sketch, which the library sources never see.
+// #define SSD1353_STATS
+
+#ifdef SSD1353_STATS
+// Primitive slots of SSD1353Stats::calls and SSD1353Stats::micros
+#define SSD1353_STAT_LINE       0
+#define SSD1353_STAT_RECTANGLE  1
+#define SSD1353_STAT_CHAR       2
+#define SSD1353_STAT_FILL       3 // Rectangles covering the whole display
+#define SSD1353_STAT_PRIMITIVES 4
+
+#define SSD1353_STAT(statement) statement
+#else
+#define SSD1353_STAT(statement)
+#endif
+
+// Typical time of one bus byte, used by cost estimates such as SSD1353FrameDiff
+#ifndef SSD1353_BUS_BYTE_NS
+#if defined(portOutputRegister) && !defined(SSD1353_NO_FAST_BUS)
+#define SSD1353_BUS_BYTE_NS 1000
+#else
+#define SSD1353_BUS_BYTE_NS 40000 // Ten digitalWrite() calls
+#endif
+#endif
+
+// Pack 6-bit red, green and blue values into a 16-bit RGB565 pixel
+#define SSD1353_RGB(red, green, blue) ((uint16_t)((((red) >> 1) << 11) | (((green) & 0x3F) << 5) | ((blue) >> 1)))
+
+// Direct port register access is used for the bus when the core provides it
+#if defined(portOutputRegister) && !defined(SSD1353_NO_FAST_BUS)
+#define SSD1353_FAST_BUS
+#endif
+
+#ifndef SSD1353_PORT_T
+#if defined(__AVR__)
+#define SSD1353_PORT_T uint8_t
+#else
+#define SSD1353_PORT_T uint32_t
+#endif
+#endif
+
+#ifndef SSD1353_PORT_REG
+#define SSD1353_PORT_REG volatile SSD1353_PORT_T*
+#endif
+
+// Interrupt masking for cores other than AVR, Cortex-M and ESP8266:
+// SSD1353_IRQ_SAVE() masks interrupts and returns the state before as a
+// uint32_t, SSD1353_IRQ_RESTORE(state) puts it back. Without them
+// interrupts are masked and enabled with noInterrupts() and interrupts().
+
+// Bytes poll() sends per call unless told otherwise
+#ifndef SSD1353_POLL_BUDGET
+#define SSD1353_POLL_BUDGET 64
+#endif
+
+// Queue segment header: type in bits 7-6, length - 1 in bits 5-0
+#define SSD1353_QUEUE_DATA    0x00
+#define SSD1353_QUEUE_COMMAND 0x40
+#define SSD1353_QUEUE_ACCEL   0x80 // Followed by the engine time in microseconds, 16 bits
+#define SSD1353_QUEUE_WAIT    0xC0 // Wait for the engine
+#define SSD1353_QUEUE_SEGMENT 64
+
+// Smallest SSD1353Queue buffer beginAsync() accepts, one full segment and its header
+#define SSD1353_QUEUE_MIN (SSD1353_QUEUE_SEGMENT + 1)
+
+// Nesting depth of pushClip(), 0 leaves the clip stack out
+#ifndef SSD1353_CLIP_DEPTH
+#define SSD1353_CLIP_DEPTH 4
+#endif
+
+// Grayscale table size and largest pulse width for setGammaTable()
+#define SSD1353_GAMMA_ENTRIES 63
+#ifndef SSD1353_GAMMA_MAX
+#define SSD1353_GAMMA_MAX 180
+#endif
+
+// Pixel formats for setColorDepth(), the remap register color depth bits
+#define SSD1353_COLOR_65K  0x40
+#define SSD1353_COLOR_262K 0xC0
+
+// RGB565 color packed into 16 bits
+struct Color565 {
+  uint16_t value;
+
+  constexpr Color565()
+      : value(0) {}
+  constexpr explicit Color565(uint16_t packed)
+      : value(packed) {}
+  // From 8-bit red, green and blue values
+  constexpr Color565(uint8_t red, uint8_t green, uint8_t blue)
+      : value(((red & 0xF8) << 8) | ((green & 0xFC) << 3) | (blue >> 3)) {}
+
+  // 6-bit channel values as taken by the drawing commands
+  constexpr uint8_t red() const { return ((value >> 11) << 1) | (value >> 15); }
+  constexpr uint8_t green() const { return (value >> 5) & 0x3F; }
+  constexpr uint8_t blue() const { return ((value & 0x1F) << 1) | ((value >> 4) & 1); }
+
+  constexpr bool operator==(const Color565& other) const { return value == other.value; }
+  constexpr bool operator!=(const Color565& other) const { return value != other.value; }
+};
+
+// Inclusive rectangle in display coordinates
+struct SSD1353Rect {
+  uint8_t x0,
+      y0,
+      x1,
+      y1;
+};
+
+// Point in display coordinates
+struct SSD1353Point {
+  uint8_t x,
+      y;
+};
+
+#ifdef SSD1353_STATS
+struct SSD1353Stats {
+  uint32_t commands;   // Command bytes sent
+  uint32_t dataBytes;  // Data bytes sent
+  uint32_t fills;      // Filled rectangles drawn by the drawing engine
+  uint32_t waitMicros; // Time blocked waiting for the drawing engine
+  uint32_t calls[SSD1353_STAT_PRIMITIVES];
+  uint32_t micros[SSD1353_STAT_PRIMITIVES]; // Time spent in each primitive, waits included
+};
+#endif
+
+// Drawing surface shared by the display drivers and the in-memory canvases
+class SSD1353Gfx {
   public:
-  void init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF, uint8_t pinD0, uint8_t pinD1, uint8_t pinD2, uint8_t pinD3, uint8_t pinD4, uint8_t pinD5, uint8_t pinD6, uint8_t pinD7);
-  void displayMode(uint8_t mode);
-  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
-  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue);
+  virtual void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) = 0;
+  virtual void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) = 0;
   void drawDot(uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
   void fill(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
   void clear();
-  void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+  virtual void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+  virtual void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
   void printstr(const char* input, uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+  void printstr(const char* input, uint8_t x, uint8_t y, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+
+  // Shapes built from hardware rectangles and lines, see SSD1353Shapes.cpp
+  void drawCircle(uint8_t x, uint8_t y, uint8_t radius, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawEllipse(uint8_t x, uint8_t y, uint8_t radiusX, uint8_t radiusY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawRoundRect(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t radius, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawPolygon(const SSD1353Point* points, uint8_t count, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+
+  // Packed color versions of the calls above
+  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, Color565 line, Color565 fill, bool useFill) {
+    drawRectangle(startX, startY, endX, endY, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
+  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, Color565 color) {
+    drawLine(startX, startY, endX, endY, color.red(), color.green(), color.blue());
+  }
+  void drawDot(uint8_t x, uint8_t y, Color565 color) { drawDot(x, y, color.red(), color.green(), color.blue()); }
+  void fill(Color565 color) { fill(color.red(), color.green(), color.blue()); }
+  void printchar(uint8_t x, uint8_t y, char character, Color565 color) { printchar(x, y, character, color.red(), color.green(), color.blue()); }
+  void printchar(uint8_t x, uint8_t y, char character, Color565 color, Color565 background) {
+    printchar(x, y, character, color.red(), color.green(), color.blue(), background.red(), background.green(), background.blue());
+  }
+  void printstr(const char* input, uint8_t x, uint8_t y, Color565 color) { printstr(input, x, y, color.red(), color.green(), color.blue()); }
+  void printstr(const char* input, uint8_t x, uint8_t y, Color565 color, Color565 background) {
+    printstr(input, x, y, color.red(), color.green(), color.blue(), background.red(), background.green(), background.blue());
+  }
+  void drawCircle(uint8_t x, uint8_t y, uint8_t radius, Color565 line, Color565 fill, bool useFill) {
+    drawCircle(x, y, radius, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
+  void drawEllipse(uint8_t x, uint8_t y, uint8_t radiusX, uint8_t radiusY, Color565 line, Color565 fill, bool useFill) {
+    drawEllipse(x, y, radiusX, radiusY, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
+  void drawRoundRect(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t radius, Color565 line, Color565 fill, bool useFill) {
+    drawRoundRect(startX, startY, endX, endY, radius, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
+  void drawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, Color565 line, Color565 fill, bool useFill) {
+    drawTriangle(x0, y0, x1, y1, x2, y2, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
+  void drawPolygon(const SSD1353Point* points, uint8_t count, Color565 line, Color565 fill, bool useFill) {
+    drawPolygon(points, count, line.red(), line.green(), line.blue(), fill.red(), fill.green(), fill.blue(), useFill);
+  }
 
   private:
+  void drawRound(int16_t left, int16_t right, int16_t top, int16_t bottom, uint8_t radiusX, uint8_t radiusY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+};
+
+class SSD1353Queue; // See SSD1353Queue.h
+
+class SSD1353Base : public SSD1353Gfx {
+  public:
+  void displayMode(uint8_t mode);
+  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue);
+  using SSD1353Gfx::drawRectangle;
+  using SSD1353Gfx::drawLine;
+  using SSD1353Gfx::printchar;
+  void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+  void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+  bool pushClip(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY);
+  void popClip();
+  const SSD1353Rect& clip() const { return _clip[_clipDepth]; }
+  bool clipRect(SSD1353Rect& rect) const;
+  virtual void setColorDepth(uint8_t depth);
+  void setGammaTable(const uint8_t* table);
+  void resetGammaTable();
+  uint8_t colorDepth() const { return _colorDepth; }
+  void setWindow(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY);
+  void writePixels(const uint16_t* pixels, uint16_t count);
+  void drawBitmap(uint8_t x, uint8_t y, uint8_t width, uint8_t height, const uint16_t* pixels);
+  bool drawImage(uint8_t x, uint8_t y, const uint8_t* image);
+  bool drawImage(uint8_t x, uint8_t y, Stream& stream);
+  void copyArea(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t newX, uint8_t newY);
+  void startScroll(uint8_t startY, uint8_t rows, int8_t horizontal, int8_t vertical, uint8_t interval);
+  void stopScroll();
+  bool scrolling() const { return _scrolling; }
+
+  void beginWrite();
+  void endWrite();
+  void writeCommand(uint8_t command, const uint8_t* args = nullptr, uint8_t length = 0);
+  void writeData(const uint8_t* data, uint16_t length);
+
+  void setAccelTiming(uint16_t baseMicros, uint16_t nanosPerPixel);
+  uint16_t accelBase() const { return _accelBase; }
+  uint16_t accelNanos() const { return _accelNanos; }
+  virtual uint16_t busByteNanos() const { return SSD1353_BUS_BYTE_NS; }
+  bool busy();
+  void waitIdle();
+
+  bool beginAsync(SSD1353Queue& queue, void (*onComplete)() = nullptr);
+  void endAsync();
+  bool poll(uint16_t budget = SSD1353_POLL_BUDGET);
+  uint16_t queued() const;
+  uint16_t queueFree() const;
+
+#ifdef SSD1353_STATS
+  const SSD1353Stats& stats() const { return _stats; }
+  void resetStats() { memset(&_stats, 0, sizeof(_stats)); }
+#endif
+
+  protected:
+  void initSequence();
+  void commandsShared();
+  void colorDepthShared(uint8_t colorDepth);
+  virtual void busBegin() {}
+  virtual void busEnd() {}
+  virtual void busWrite(const uint8_t* data, uint16_t length, bool isCommand) = 0;
+
+  private:
+  uint8_t _writeDepth             = 0;
+  volatile bool _accelBusy        = false;
+  bool _scrolling                 = false;
+  uint8_t _colorDepth             = SSD1353_COLOR_262K;
+  uint8_t _fillMode               = 0xFF; // Last rectangle fill setting sent, 0xFF when unknown
+  volatile uint32_t _accelUntil   = 0;
+  uint16_t _accelBase             = SSD1353_ACCEL_BASE_US;
+  uint16_t _accelNanos            = SSD1353_ACCEL_NS_PER_PIXEL;
+
+  SSD1353Queue* _queue            = nullptr; // Asynchronous transfer queue, nullptr when off
+
+  // Clip rectangles, the first is the whole display. Empty when x0 > x1.
+#if SSD1353_CLIP_DEPTH
+  SSD1353Rect _clip[SSD1353_CLIP_DEPTH + 1] = {{0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1}};
+  uint8_t _clipDepth                        = 0;
+#else
+  static const SSD1353Rect _clip[1];
+  static const uint8_t _clipDepth = 0;
+#endif
+
+#ifdef SSD1353_STATS
+  SSD1353Stats _stats = {};
+  uint8_t _statDepth  = 0; // Primitives in progress, only the outermost is timed
+
+  class StatScope;
+#endif
+
+  // Holds off interrupts while in scope, around queue state that poll()
+  // may change from an interrupt. The interrupt state from before comes
+  // back at the end, so locks nest and poll() may take one in a handler.
+  class QueueLock {
+    public:
+#if defined(__AVR__)
+    QueueLock()
+        : _state(SREG) { cli(); }
+    ~QueueLock() { SREG = _state; }
+
+    private:
+    uint8_t _state;
+#elif defined(__ARM_ARCH_PROFILE) && __ARM_ARCH_PROFILE == 'M'
+    QueueLock() {
+      __asm__ volatile("mrs %0, primask" : "=r"(_state));
+      __asm__ volatile("cpsid i" ::: "memory");
+    }
+    ~QueueLock() { __asm__ volatile("msr primask, %0" ::"r"(_state) : "memory"); }
+
+    private:
+    uint32_t _state;
+#elif defined(ESP8266)
+    QueueLock()
+        : _state(xt_rsil(15)) {}
+    ~QueueLock() { xt_wsr_ps(_state); }
+
+    private:
+    uint32_t _state;
+#elif defined(SSD1353_IRQ_SAVE)
+    QueueLock()
+        : _state(SSD1353_IRQ_SAVE()) {}
+    ~QueueLock() { SSD1353_IRQ_RESTORE(_state); }
+
+    private:
+    uint32_t _state;
+#else
+    // Without a way to read the state only the outermost lock enables
+    // interrupts again, here poll() must not be called from a handler
+    QueueLock() {
+      noInterrupts();
+      depth()++;
+    }
+    ~QueueLock() {
+      if (!--depth())
+        interrupts();
+    }
+
+    private:
+    static uint8_t& depth() {
+      static uint8_t locks = 0;
+      return locks;
+    }
+#endif
+  };
+
+  void enableFill(bool enable);
+  void rectangleCommand(const SSD1353Rect& rect, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void needEngine();
+  void waitEngine();
+  void sendBus(const uint8_t* data, uint16_t length, bool isCommand);
+  void queueReserve(uint16_t length);
+  void queuePush(uint8_t value);
+  uint8_t queuePop();
+  void queueMarker(uint8_t marker, uint16_t micros = 0);
+  void queueFinish();
+  bool drain(uint16_t budget, bool block);
+  bool engineBusy();
+  uint8_t packPixel(uint8_t* out, uint8_t red, uint8_t green, uint8_t blue) const;
+  void startAccel(uint16_t baseMicros, uint32_t pixels);
+};
+
+// DC and D0-D7 of the 8080-style parallel bus, chip select is left to the
+// owner so several panels can share the bus
+class SSD1353ParallelBus {
+  public:
+  void init(uint8_t pinDC, const uint8_t* pinD);
+  void setCommand(bool isCommand);
+  void put(uint8_t data);
+
+  private:
+  uint8_t _pinDC;
+  uint8_t _pinD[8];
+
+#ifdef SSD1353_FAST_BUS
+  SSD1353_PORT_REG _regDC;
+  SSD1353_PORT_T _maskDC;
+
+  SSD1353_PORT_REG _busReg[8]; // Output register of each distinct data bus port
+  SSD1353_PORT_T _busMask[8];  // All data bus bits on each port
+  SSD1353_PORT_T _bitMask[8];  // Port bit of each data line
+  uint8_t _bitPort[8];         // Index into _busReg of each data line
+  uint8_t _busPorts;           // Number of distinct data bus ports
+  uint8_t _busShift;           // Bit position of D0 when D0-D7 are contiguous on one port, else 0xFF
+#endif
+};
+
+class SSD1353 : public SSD1353Base {
+  public:
+  void init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF, uint8_t pinD0, uint8_t pinD1, uint8_t pinD2, uint8_t pinD3, uint8_t pinD4, uint8_t pinD5, uint8_t pinD6, uint8_t pinD7);
+
+  protected:
+  void busWrite(const uint8_t* data, uint16_t length, bool isCommand);
+
+  private:
+  SSD1353ParallelBus _bus;
   uint8_t _pinCS,
-      _pinDC,
       _pinRS,
       _pinDISF;
-  uint8_t _pinD[8];
-  
-  void write(uint8_t data, bool isCommand);
-  void enableFill(bool enable);
+
+#ifdef SSD1353_FAST_BUS
+  SSD1353_PORT_REG _regCS;
+  SSD1353_PORT_T _maskCS;
+#endif
 };
 
 #endif
@@ -0,0 +1,299 @@
+/*
+  SSD1353Async.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353.h"
+#include "SSD1353Queue.h"
+#include <Arduino.h>
+
+#define QUEUE_TYPE   0xC0
+#define QUEUE_LENGTH 0x3F
+#define QUEUE_NONE   0xFFFF
+
+/**
+ * @brief Queue bus traffic instead of sending it right away
+ *
+ * Drawing calls return once their bytes are in the queue, poll() sends
+ * them later. Engine waits are queued too, so a draw call never blocks
+ * unless the queue is full; then it sends until there is room.
+ *
+ * onComplete runs when the queue has been sent empty and no
+ * beginWrite()/endWrite() transaction is open, from poll(), waitIdle() or
+ * the endWrite() that closes the transaction. Wrap a frame in
+ * beginWrite()/endWrite() to be told once per frame.
+ *
+ * @param queue Queue to use, its buffer at least SSD1353_QUEUE_MIN bytes
+ * @param onComplete Called when the queue runs empty, or nullptr
+ * @return true on success, false if the buffer is too small
+ */
+bool SSD1353Base::beginAsync(SSD1353Queue& queue, void (*onComplete)()) {
+  if (!queue._buffer || queue._size < SSD1353_QUEUE_MIN)
+    return false;
+
+  endAsync();
+  queue._head       = 0;
+  queue._tail       = 0;
+  queue._count      = 0;
+  queue._last       = QUEUE_NONE;
+  queue._readLeft   = 0;
+  queue._draining   = false;
+  queue._sent       = false;
+  queue._onComplete = onComplete;
+
+  QueueLock lock;
+  _queue = &queue;
+  return true;
+}
+
+/**
+ * @brief Send everything queued and go back to direct bus writes
+ *
+ */
+void SSD1353Base::endAsync() {
+  if (!_queue)
+    return;
+
+  while (queued())
+    drain(0xFFFF, true);
+  queueFinish();
+
+  QueueLock lock;
+  _queue = nullptr;
+}
+
+/**
+ * @brief Send part of the queue
+ *
+ * Call from loop() or from a timer interrupt. Returns early without
+ * waiting when the next command needs the drawing engine and it is still
+ * busy. In an interrupt it returns at once while a drawing call or
+ * waitIdle() is sending the queue itself. Nothing else may use the bus
+ * while poll() can run from an interrupt, on SPI register the interrupt
+ * with SPI.usingInterrupt().
+ *
+ * @param budget Most bytes to send in this call
+ * @return true while the queue still holds something
+ */
+bool SSD1353Base::poll(uint16_t budget) {
+  if (!_queue)
+    return false;
+
+  bool left = drain(budget, false);
+  queueFinish();
+  return left;
+}
+
+/**
+ * @brief Number of bytes waiting in the queue
+ *
+ * @return Queued bytes, markers included
+ */
+uint16_t SSD1353Base::queued() const {
+  QueueLock lock;
+  return _queue ? _queue->_count : 0;
+}
+
+/**
+ * @brief Room left in the queue, a draw call that needs more blocks
+ *
+ * @return Free bytes
+ */
+uint16_t SSD1353Base::queueFree() const {
+  QueueLock lock;
+  return _queue ? _queue->_size - _queue->_count : 0;
+}
+
+/**
+ * @brief Queue bus bytes, or write them directly when the queue is off
+ *
+ * @param data Pointer to the bytes
+ * @param length Number of bytes
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353Base::sendBus(const uint8_t* data, uint16_t length, bool isCommand) {
+  SSD1353_STAT((isCommand ? _stats.commands : _stats.dataBytes) += length);
+
+  if (!_queue) {
+    busWrite(data, length, isCommand);
+    return;
+  }
+
+  SSD1353Queue& queue = *_queue;
+  uint8_t type        = isCommand ? SSD1353_QUEUE_COMMAND : SSD1353_QUEUE_DATA;
+  while (length) {
+    uint8_t n = length > SSD1353_QUEUE_SEGMENT ? SSD1353_QUEUE_SEGMENT : length;
+    queueReserve(n + 1);
+
+    // Interrupts stay off for one segment at most, so poll() never finds a
+    // header whose bytes are not all there
+    QueueLock lock;
+    uint16_t added = n;
+    uint16_t last  = queue._last;
+
+    // Grow the last segment while it has not been started on
+    if (last != QUEUE_NONE && (queue._buffer[last] & QUEUE_TYPE) == type && (queue._buffer[last] & QUEUE_LENGTH) + 1 + n <= SSD1353_QUEUE_SEGMENT) {
+      queue._buffer[last] += n;
+    } else {
+      queue._last = queue._tail;
+      queuePush(type | (n - 1));
+      added++;
+    }
+
+    for (uint8_t i = 0; i < n; i++)
+      queuePush(data[i]);
+    queue._count += added;
+    data += n;
+    length -= n;
+  }
+}
+
+/**
+ * @brief Queue a drawing engine marker
+ *
+ * @param marker SSD1353_QUEUE_ACCEL or SSD1353_QUEUE_WAIT
+ * @param micros Engine time for SSD1353_QUEUE_ACCEL
+ */
+void SSD1353Base::queueMarker(uint8_t marker, uint16_t micros) {
+  uint8_t length = marker == SSD1353_QUEUE_ACCEL ? 3 : 1;
+  queueReserve(length);
+
+  QueueLock lock;
+  _queue->_last = QUEUE_NONE;
+  queuePush(marker);
+  if (marker == SSD1353_QUEUE_ACCEL) {
+    queuePush(micros);
+    queuePush(micros >> 8);
+  }
+  _queue->_count += length;
+}
+
+/**
+ * @brief Send queued bytes until there is room for more
+ *
+ * @param length Bytes needed
+ */
+void SSD1353Base::queueReserve(uint16_t length) {
+  uint16_t room;
+  while ((room = queueFree()) < length)
+    drain(length - room, true);
+}
+
+/**
+ * @brief Write a byte at the tail, counted in by the caller
+ *
+ * @param value Byte to add
+ */
+void SSD1353Base::queuePush(uint8_t value) {
+  SSD1353Queue& queue        = *_queue;
+  queue._buffer[queue._tail] = value;
+  if (++queue._tail == queue._size)
+    queue._tail = 0;
+}
+
+uint8_t SSD1353Base::queuePop() {
+  SSD1353Queue& queue = *_queue;
+  uint8_t value       = queue._buffer[queue._head];
+  if (++queue._head == queue._size)
+    queue._head = 0;
+  queue._count--;
+  return value;
+}
+
+/**
+ * @brief Call onComplete if the queue was sent empty outside a transaction
+ *
+ */
+void SSD1353Base::queueFinish() {
+  SSD1353Queue& queue = *_queue;
+  bool done;
+  {
+    QueueLock lock;
+    done = queue._sent && !queue._draining && !queue._count && !_writeDepth;
+    if (done)
+      queue._sent = false;
+  }
+  if (done && queue._onComplete)
+    queue._onComplete();
+}
+
+/**
+ * @brief Send bytes from the front of the queue
+ *
+ * Whoever drains owns the bus until done, a poll() from an interrupt
+ * meanwhile leaves at once. Only the drawing calls add to the queue and
+ * they never run inside drain(), so the head side needs no lock.
+ *
+ * @param budget Most bus bytes to send
+ * @param block Wait for the drawing engine instead of returning
+ * @return true while the queue still holds something
+ */
+bool SSD1353Base::drain(uint16_t budget, bool block) {
+  SSD1353Queue& queue = *_queue;
+  {
+    QueueLock lock;
+    if (queue._draining)
+      return true;
+    queue._draining = true;
+  }
+  if (!queue._count) {
+    queue._draining = false;
+    return false;
+  }
+
+  busBegin();
+  while (queue._count && budget) {
+    if (!queue._readLeft) {
+      if (queue._head == queue._last)
+        queue._last = QUEUE_NONE;
+
+      uint8_t header = queue._buffer[queue._head];
+      uint8_t type   = header & QUEUE_TYPE;
+      if (type == SSD1353_QUEUE_WAIT) {
+        if (!block && engineBusy())
+          break;
+        waitEngine();
+        queuePop();
+        continue;
+      }
+      queuePop();
+      if (type == SSD1353_QUEUE_ACCEL) {
+        uint16_t duration = queuePop();
+        duration |= queuePop() << 8;
+        _accelUntil = micros() + duration;
+        _accelBusy  = true;
+        continue;
+      }
+      queue._readCommand = type == SSD1353_QUEUE_COMMAND;
+      queue._readLeft    = (header & QUEUE_LENGTH) + 1;
+    }
+
+    // Send up to the end of the segment, the budget or the buffer end
+    uint16_t n = queue._readLeft;
+    if (n > budget)
+      n = budget;
+    if (n > queue._size - queue._head)
+      n = queue._size - queue._head;
+    busWrite(queue._buffer + queue._head, n, queue._readCommand);
+    queue._head = (queue._head + n) % queue._size;
+    queue._count -= n;
+    queue._sent = true;
+    queue._readLeft -= n;
+    budget -= n;
+  }
+  busEnd();
+
+  bool left       = queue._count;
+  queue._draining = false;
+  return left;
+}
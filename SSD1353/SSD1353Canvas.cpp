@@ -0,0 +1,217 @@
+/*
+  SSD1353Canvas.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Canvas.h"
+#include <Arduino.h>
+
+/**
+ * @brief Construct a canvas on a caller supplied pixel buffer
+ *
+ * @param buffer Pointer to width * height pixels, bottom row first
+ * @param width Canvas width
+ * @param height Canvas height
+ * @param originX Display X coordinate of the canvas bottom left corner
+ * @param originY Display Y coordinate of the canvas bottom left corner
+ */
+SSD1353Canvas::SSD1353Canvas(uint16_t* buffer, uint8_t width, uint8_t height, uint8_t originX, uint8_t originY)
+    : _buffer(buffer), _width(width), _height(height), _originX(originX), _originY(originY) {}
+
+/**
+ * @brief Move the canvas to another place on the display
+ *
+ * @param originX Display X coordinate of the canvas bottom left corner
+ * @param originY Display Y coordinate of the canvas bottom left corner
+ */
+void SSD1353Canvas::setOrigin(uint8_t originX, uint8_t originY) {
+  _originX = originX;
+  _originY = originY;
+}
+
+/**
+ * @brief Set a pixel, coordinates outside the canvas are ignored
+ *
+ * @param x Display X coordinate
+ * @param y Display Y coordinate
+ * @param color RGB565 pixel value
+ */
+void SSD1353Canvas::setPixel(uint8_t x, uint8_t y, uint16_t color) {
+  if (x < _originX || y < _originY || x - _originX >= _width || y - _originY >= _height)
+    return;
+  _buffer[(uint16_t)(y - _originY) * _width + (x - _originX)] = color;
+}
+
+/**
+ * @brief Read a pixel
+ *
+ * @param x Display X coordinate
+ * @param y Display Y coordinate
+ * @return uint16_t RGB565 pixel value, 0 outside the canvas
+ */
+uint16_t SSD1353Canvas::getPixel(uint8_t x, uint8_t y) const {
+  if (x < _originX || y < _originY || x - _originX >= _width || y - _originY >= _height)
+    return 0;
+  return _buffer[(uint16_t)(y - _originY) * _width + (x - _originX)];
+}
+
+/**
+ * @brief Fill a rectangle with one color, clipped to the canvas
+ *
+ * @param startX First corner X coordinate
+ * @param startY First corner Y coordinate
+ * @param endX Opposite corner X coordinate
+ * @param endY Opposite corner Y coordinate
+ * @param color RGB565 pixel value
+ */
+void SSD1353Canvas::fillRect(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint16_t color) {
+  int16_t x0 = min(startX, endX) - _originX;
+  int16_t x1 = max(startX, endX) - _originX;
+  int16_t y0 = min(startY, endY) - _originY;
+  int16_t y1 = max(startY, endY) - _originY;
+
+  if (x0 < 0)
+    x0 = 0;
+  if (y0 < 0)
+    y0 = 0;
+  if (x1 >= _width)
+    x1 = _width - 1;
+  if (y1 >= _height)
+    y1 = _height - 1;
+
+  for (int16_t y = y0; y <= y1; y++) {
+    uint16_t* row = _buffer + (uint16_t)y * _width;
+    for (int16_t x = x0; x <= x1; x++)
+      row[x] = color;
+  }
+}
+
+/**
+ * @brief Draw a rectangle on the canvas
+ *
+ * @param startX Bottom left corner X coordinate
+ * @param startY Bottom left corner Y coordinate
+ * @param endX Top right corner X coordinate
+ * @param endY Top right corner Y coordinate
+ * @param lineRed Border line red color value
+ * @param lineGreen Border line green color value
+ * @param lineBlue Border line blue color value
+ * @param fillRed Rectangle fill red color value
+ * @param fillGreen Rectangle fill green color value
+ * @param fillBlue Rectangle fill blue color value
+ * @param useFill Fill the rectangle, true/false
+ */
+void SSD1353Canvas::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  uint16_t line = SSD1353_RGB(lineRed, lineGreen, lineBlue);
+  uint8_t x0    = min(startX, endX);
+  uint8_t x1    = max(startX, endX);
+  uint8_t y0    = min(startY, endY);
+  uint8_t y1    = max(startY, endY);
+
+  if (useFill && x1 - x0 > 1 && y1 - y0 > 1)
+    fillRect(x0 + 1, y0 + 1, x1 - 1, y1 - 1, SSD1353_RGB(fillRed, fillGreen, fillBlue));
+
+  fillRect(x0, y0, x1, y0, line);
+  fillRect(x0, y1, x1, y1, line);
+  fillRect(x0, y0, x0, y1, line);
+  fillRect(x1, y0, x1, y1, line);
+}
+
+/**
+ * @brief Draw a line on the canvas
+ *
+ * @param startX Starting point X coordinate
+ * @param startY Starting point Y coordinate
+ * @param endX Ending point X coordinate
+ * @param endY Ending point Y coordinate
+ * @param lineRed Line red color value
+ * @param lineGreen Line green color  value
+ * @param lineBlue Line blue color value
+ */
+void SSD1353Canvas::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) {
+  uint16_t color = SSD1353_RGB(lineRed, lineGreen, lineBlue);
+
+  if (startX == endX || startY == endY) {
+    fillRect(startX, startY, endX, endY, color);
+    return;
+  }
+
+  // Bresenham
+  int16_t dx  = abs(endX - startX);
+  int16_t dy  = -abs(endY - startY);
+  int8_t sx   = startX < endX ? 1 : -1;
+  int8_t sy   = startY < endY ? 1 : -1;
+  int16_t err = dx + dy;
+  int16_t x   = startX;
+  int16_t y   = startY;
+
+  while (true) {
+    setPixel(x, y, color);
+    if (x == endX && y == endY)
+      break;
+    int16_t e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      y += sy;
+    }
+  }
+}
+
+/**
+ * @brief Send the canvas to its place on the display in one RAM write
+ *
+ * Only the part inside the display's clip rectangle is sent.
+ *
+ * @param display Target display
+ */
+void SSD1353Canvas::flush(SSD1353Base& display) {
+  SSD1353Rect all = {0, 0, 0xFF, 0xFF};
+  flush(display, all);
+}
+
+/**
+ * @brief Send part of the canvas to the display in one RAM write
+ *
+ * @param display Target display
+ * @param area Display area to send, clipped to the canvas and the display's clip rectangle
+ */
+void SSD1353Canvas::flush(SSD1353Base& display, const SSD1353Rect& area) {
+  int16_t right = min(area.x1, _originX + _width - 1);
+  int16_t top   = min(area.y1, _originY + _height - 1);
+  if (right < 0 || top < 0)
+    return;
+
+  SSD1353Rect visible = {max(area.x0, _originX), max(area.y0, _originY), (uint8_t)right, (uint8_t)top};
+  if (!display.clipRect(visible))
+    return;
+
+  uint8_t width = visible.x1 - visible.x0 + 1;
+  display.beginWrite();
+  display.setWindow(visible.x0, visible.y0, visible.x1, visible.y1);
+  if (width == _width) {
+    display.writePixels(_buffer + (uint16_t)(visible.y0 - _originY) * _width, (uint16_t)width * (visible.y1 - visible.y0 + 1));
+  } else {
+    for (uint8_t y = visible.y0; y <= visible.y1; y++)
+      display.writePixels(_buffer + (uint16_t)(y - _originY) * _width + (visible.x0 - _originX), width);
+  }
+  display.endWrite();
+}
+
+#ifndef __AVR__
+SSD1353Framebuffer::SSD1353Framebuffer()
+    : SSD1353Canvas(_pixels, SSD1353_WIDTH, SSD1353_HEIGHT) {}
+#endif
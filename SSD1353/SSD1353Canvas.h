@@ -0,0 +1,63 @@
+/*
+  SSD1353Canvas.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353CANVAS_H
+#define SSD1353CANVAS_H
+
+#include "SSD1353.h"
+
+// Drawing surface backed by a block of RGB565 pixels in RAM
+class SSD1353Canvas : public SSD1353Gfx {
+  public:
+  SSD1353Canvas(uint16_t* buffer, uint8_t width, uint8_t height, uint8_t originX = 0, uint8_t originY = 0);
+
+  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue);
+  using SSD1353Gfx::drawRectangle;
+  using SSD1353Gfx::drawLine;
+  void fillRect(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint16_t color);
+  void setPixel(uint8_t x, uint8_t y, uint16_t color);
+  uint16_t getPixel(uint8_t x, uint8_t y) const;
+  void setOrigin(uint8_t originX, uint8_t originY);
+  void flush(SSD1353Base& display);
+  void flush(SSD1353Base& display, const SSD1353Rect& area);
+
+  uint16_t* buffer() const { return _buffer; }
+  uint8_t width() const { return _width; }
+  uint8_t height() const { return _height; }
+  uint8_t originX() const { return _originX; }
+  uint8_t originY() const { return _originY; }
+
+  protected:
+  uint16_t* _buffer;
+  uint8_t _width,
+      _height,
+      _originX,
+      _originY;
+};
+
+// Canvas covering the whole display, 40 kB of RAM. Left out on AVR, whose
+// objects are limited to 32 kB; pass a buffer to SSD1353Canvas instead.
+#ifndef __AVR__
+class SSD1353Framebuffer : public SSD1353Canvas {
+  public:
+  SSD1353Framebuffer();
+
+  private:
+  uint16_t _pixels[SSD1353_WIDTH * SSD1353_HEIGHT];
+};
+#endif
+
+#endif
@@ -0,0 +1,173 @@
+/*
+  SSD1353Chart.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Chart.h"
+#include <Arduino.h>
+
+/**
+ * @brief Construct a strip chart
+ *
+ * The plot area is not drawn, call clear() before the first sample.
+ *
+ * @param display Display the chart is drawn on
+ * @param x Plot area bottom left corner X coordinate
+ * @param y Plot area bottom left corner Y coordinate
+ * @param width Plot area width, one column per sample
+ * @param height Plot area height
+ */
+SSD1353Chart::SSD1353Chart(SSD1353Base& display, uint8_t x, uint8_t y, uint8_t width, uint8_t height)
+    : _display(display), _x(x), _y(y), _width(width), _height(height) {}
+
+/**
+ * @brief Set the values shown at the bottom and top of the plot area
+ *
+ * Values outside the range are drawn at the nearest edge.
+ *
+ * @param minimum Value at the bottom row
+ * @param maximum Value at the top row
+ */
+void SSD1353Chart::setRange(int16_t minimum, int16_t maximum) {
+  _minimum = minimum;
+  _maximum = maximum;
+}
+
+/**
+ * @brief Set the plot area background color, used from the next clear()
+ *
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Chart::setBackground(uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  _background[0] = backgroundRed;
+  _background[1] = backgroundGreen;
+  _background[2] = backgroundBlue;
+}
+
+/**
+ * @brief Set the gridlines, used from the next clear()
+ *
+ * @param rowSpacing Rows between horizontal gridlines, 0 for none
+ * @param columnSpacing Samples between vertical gridlines, 0 for none
+ * @param gridRed Gridline red color value
+ * @param gridGreen Gridline green color value
+ * @param gridBlue Gridline blue color value
+ */
+void SSD1353Chart::setGrid(uint8_t rowSpacing, uint8_t columnSpacing, uint8_t gridRed, uint8_t gridGreen, uint8_t gridBlue) {
+  _rowSpacing    = rowSpacing;
+  _columnSpacing = columnSpacing;
+  _grid[0]       = gridRed;
+  _grid[1]       = gridGreen;
+  _grid[2]       = gridBlue;
+}
+
+/**
+ * @brief Add a trace to the chart
+ *
+ * @param valueRed Trace red color value
+ * @param valueGreen Trace green color value
+ * @param valueBlue Trace blue color value
+ * @return Index of the trace in the plot() values, -1 if all SSD1353_CHART_TRACES are taken
+ */
+int8_t SSD1353Chart::addTrace(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+  if (_traceCount == SSD1353_CHART_TRACES)
+    return -1;
+
+  _traceColor[_traceCount][0] = valueRed;
+  _traceColor[_traceCount][1] = valueGreen;
+  _traceColor[_traceCount][2] = valueBlue;
+  return _traceCount++;
+}
+
+/**
+ * @brief Draw an empty plot area with its gridlines
+ *
+ */
+void SSD1353Chart::clear() {
+  uint8_t endX = _x + _width - 1;
+
+  _display.drawRectangle(_x, _y, endX, _y + _height - 1, _background[0], _background[1], _background[2], _background[0], _background[1], _background[2], true);
+  if (_rowSpacing)
+    for (uint8_t row = 0; row < _height; row += _rowSpacing)
+      _display.drawLine(_x, _y + row, endX, _y + row, _grid[0], _grid[1], _grid[2]);
+  if (_columnSpacing)
+    for (uint8_t column = _width; column-- > 0;)
+      if ((_width - 1 - column) % _columnSpacing == 0)
+        _display.drawLine(_x + column, _y, _x + column, _y + _height - 1, _grid[0], _grid[1], _grid[2]);
+
+  _phase   = 0;
+  _hasLast = false;
+}
+
+/**
+ * @brief Add one sample of every trace at the right edge
+ *
+ * The plot moves left by one column with a single copy, then only the
+ * newly exposed column is cleared, its gridlines redrawn and each trace
+ * joined to its previous value with one vertical line. The cost does not
+ * depend on the chart width or history.
+ *
+ * @param values One value per trace, in the order the traces were added
+ */
+void SSD1353Chart::plot(const int16_t* values) {
+  uint8_t column = _x + _width - 1;
+
+  if (_width > 1)
+    _display.copyArea(_x + 1, _y, column, _y + _height - 1, _x, _y);
+  if (++_phase >= _columnSpacing)
+    _phase = 0;
+  drawGridColumn(column);
+
+  for (uint8_t i = 0; i < _traceCount; i++) {
+    uint8_t y    = valueY(values[i]);
+    uint8_t from = _hasLast ? _lastY[i] : y;
+    _display.drawLine(column, from, column, y, _traceColor[i][0], _traceColor[i][1], _traceColor[i][2]);
+    _lastY[i] = y;
+  }
+  _hasLast = true;
+}
+
+/**
+ * @brief Map a value to a display row, clamped to the plot area
+ *
+ * @param value Value to be mapped
+ * @return Display row
+ */
+uint8_t SSD1353Chart::valueY(int16_t value) const {
+  if (_maximum <= _minimum || value <= _minimum)
+    return _y;
+  if (value >= _maximum)
+    return _y + _height - 1;
+  return _y + ((int32_t)value - _minimum) * (_height - 1) / ((int32_t)_maximum - _minimum);
+}
+
+/**
+ * @brief Redraw the background and gridlines of one column
+ *
+ * @param column Display column
+ */
+void SSD1353Chart::drawGridColumn(uint8_t column) {
+  uint8_t endY = _y + _height - 1;
+
+  if (_columnSpacing && _phase == 0) {
+    _display.drawLine(column, _y, column, endY, _grid[0], _grid[1], _grid[2]);
+    return;
+  }
+
+  _display.drawLine(column, _y, column, endY, _background[0], _background[1], _background[2]);
+  if (_rowSpacing)
+    for (uint8_t row = 0; row < _height; row += _rowSpacing)
+      _display.drawDot(column, _y + row, _grid[0], _grid[1], _grid[2]);
+}
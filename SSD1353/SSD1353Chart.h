@@ -0,0 +1,63 @@
+/*
+  SSD1353Chart.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353CHART_H
+#define SSD1353CHART_H
+
+#include "SSD1353.h"
+
+#ifndef SSD1353_CHART_TRACES
+#define SSD1353_CHART_TRACES 4
+#endif
+
+// Strip chart that moves the plot left with the display's copy command and
+// draws only the newest column
+class SSD1353Chart {
+  public:
+  SSD1353Chart(SSD1353Base& display, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+  void setRange(int16_t minimum, int16_t maximum);
+  void setBackground(uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+  void setGrid(uint8_t rowSpacing, uint8_t columnSpacing, uint8_t gridRed, uint8_t gridGreen, uint8_t gridBlue);
+  int8_t addTrace(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+  void clear();
+  void plot(const int16_t* values);
+  void plot(int16_t value) { plot(&value); }
+
+  uint8_t traceCount() const { return _traceCount; }
+
+  private:
+  SSD1353Base& _display;
+  uint8_t _x;
+  uint8_t _y;
+  uint8_t _width;
+  uint8_t _height;
+  int16_t _minimum       = 0;
+  int16_t _maximum       = 1023;
+  uint8_t _rowSpacing    = 0;
+  uint8_t _columnSpacing = 0;
+  uint8_t _background[3] = {0, 0, 0};
+  uint8_t _grid[3]       = {0, 0x10, 0};
+  uint8_t _traceCount    = 0;
+  uint8_t _traceColor[SSD1353_CHART_TRACES][3];
+  uint8_t _lastY[SSD1353_CHART_TRACES];
+  bool _hasLast          = false;
+  uint8_t _phase         = 0; // Samples since the last vertical gridline
+
+  uint8_t valueY(int16_t value) const;
+  void drawGridColumn(uint8_t column);
+};
+
+#endif
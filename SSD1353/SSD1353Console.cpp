@@ -0,0 +1,147 @@
+/*
+  SSD1353Console.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Console.h"
+#include <Arduino.h>
+
+/**
+ * @brief Construct a console
+ *
+ * The region is not cleared, call clear() before the first print.
+ *
+ * @param display Display the console is drawn on
+ * @param x Region bottom left corner X coordinate
+ * @param y Region bottom left corner Y coordinate
+ * @param columns Region width in characters
+ * @param rows Region height in text rows
+ */
+SSD1353Console::SSD1353Console(SSD1353Base& display, uint8_t x, uint8_t y, uint8_t columns, uint8_t rows)
+    : _display(display), _x(x), _y(y), _columns(columns), _rows(rows) {}
+
+/**
+ * @brief Set the text and background colors
+ *
+ * @param valueRed Text color red value
+ * @param valueGreen Text color green value
+ * @param valueBlue Text color blue value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Console::setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  _color[0]      = valueRed;
+  _color[1]      = valueGreen;
+  _color[2]      = valueBlue;
+  _background[0] = backgroundRed;
+  _background[1] = backgroundGreen;
+  _background[2] = backgroundBlue;
+}
+
+/**
+ * @brief Move or resize the scroll region
+ *
+ * The cursor returns to the top left, the region is not cleared.
+ *
+ * @param x Region bottom left corner X coordinate
+ * @param y Region bottom left corner Y coordinate
+ * @param columns Region width in characters
+ * @param rows Region height in text rows
+ */
+void SSD1353Console::setRegion(uint8_t x, uint8_t y, uint8_t columns, uint8_t rows) {
+  _x              = x;
+  _y              = y;
+  _columns        = columns;
+  _rows           = rows;
+  _column         = 0;
+  _row            = 0;
+  _pendingNewline = false;
+}
+
+/**
+ * @brief Fill the region with the background color and home the cursor
+ *
+ */
+void SSD1353Console::clear() {
+  _display.drawRectangle(_x, _y, _x + _columns * 6 - 1, _y + _rows * 8 - 1, _background[0], _background[1], _background[2], _background[0], _background[1], _background[2], true);
+  _column         = 0;
+  _row            = 0;
+  _pendingNewline = false;
+}
+
+/**
+ * @brief Move the region contents up by one text row
+ *
+ * Each row is copied onto the one above it, top row first, so no copy
+ * reads pixels an earlier one has written and source and destination
+ * never overlap. One filled rectangle blanks the bottom row.
+ */
+void SSD1353Console::scroll() {
+  for (uint8_t row = 1; row < _rows; row++)
+    _display.copyArea(_x, rowY(row), _x + _columns * 6 - 1, rowY(row) + 7, _x, rowY(row - 1));
+  clearRow(_rows - 1);
+}
+
+/**
+ * @brief Write a character to the console
+ *
+ * '\n' starts a new line, '\r' returns to the start of the line. Lines
+ * longer than the region wrap. A new line is only scrolled in when text
+ * is written to it, so the bottom row stays in use after println().
+ *
+ * @param c Character to be written
+ * @return Number of characters written
+ */
+size_t SSD1353Console::write(uint8_t c) {
+  if (c == '\r') {
+    _column = 0;
+    return 1;
+  }
+  if (c == '\n') {
+    if (_pendingNewline)
+      newline();
+    _pendingNewline = true;
+    return 1;
+  }
+
+  if (_pendingNewline || _column >= _columns) {
+    newline();
+    _pendingNewline = false;
+  }
+  _display.printchar(_x + _column * 6, rowY(_row), c, _color[0], _color[1], _color[2], _background[0], _background[1], _background[2]);
+  _column++;
+  return 1;
+}
+
+/**
+ * @brief Move the cursor to the start of the next row, scrolling at the bottom
+ *
+ */
+void SSD1353Console::newline() {
+  _column = 0;
+  if (_row + 1 < _rows)
+    _row++;
+  else
+    scroll();
+}
+
+/**
+ * @brief Fill one text row with the background color
+ *
+ * @param row Row index, 0 is the top row
+ */
+void SSD1353Console::clearRow(uint8_t row) {
+  uint8_t y = rowY(row);
+  _display.drawRectangle(_x, y, _x + _columns * 6 - 1, y + 7, _background[0], _background[1], _background[2], _background[0], _background[1], _background[2], true);
+}
@@ -0,0 +1,53 @@
+/*
+  SSD1353Console.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353CONSOLE_H
+#define SSD1353CONSOLE_H
+
+#include "SSD1353.h"
+
+// Scrolling text terminal, old lines are moved up with the display's copy command
+class SSD1353Console : public Print {
+  public:
+  SSD1353Console(SSD1353Base& display, uint8_t x, uint8_t y, uint8_t columns, uint8_t rows);
+
+  void setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+  void setRegion(uint8_t x, uint8_t y, uint8_t columns, uint8_t rows);
+  void clear();
+  void scroll();
+  size_t write(uint8_t c);
+  using Print::write;
+
+  uint8_t column() const { return _column; }
+  uint8_t row() const { return _row; }
+
+  private:
+  SSD1353Base& _display;
+  uint8_t _x;
+  uint8_t _y;
+  uint8_t _columns;
+  uint8_t _rows;
+  uint8_t _column        = 0;
+  uint8_t _row           = 0;
+  bool _pendingNewline   = false;
+  uint8_t _color[3]      = {0x3F, 0x3F, 0x3F};
+  uint8_t _background[3] = {0, 0, 0};
+
+  void newline();
+  void clearRow(uint8_t row);
+  uint8_t rowY(uint8_t row) const { return _y + (_rows - 1 - row) * 8; }
+};
+
+#endif
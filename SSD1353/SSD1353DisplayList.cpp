@@ -0,0 +1,471 @@
+/*
+  SSD1353DisplayList.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353DisplayList.h"
+#include <Arduino.h>
+
+// Opcodes and the number of argument bytes that follow them
+#define OP_LINE      0x01 // startX, startY, endX, endY, red, green, blue
+#define OP_RECT      0x02 // startX, startY, endX, endY, line red, green, blue
+#define OP_RECT_FILL 0x03 // startX, startY, endX, endY, line red, green, blue, fill red, green, blue
+#define OP_CHAR      0x04 // x, y, character, red, green, blue
+#define OP_BOX       0x05 // left, bottom, right, top, red, green, blue; a solid single color rectangle
+
+// Set on the opcode of calls optimize() has removed, until the list is compacted
+#define OP_DROPPED 0x80
+
+// Rectangle fill setting a call needs on the display
+#define MODE_ANY     0
+#define MODE_OUTLINE 1
+#define MODE_FILL    2
+
+static uint8_t argLength(uint8_t opcode) {
+  switch (opcode & ~OP_DROPPED) {
+    case OP_LINE:
+    case OP_RECT:
+    case OP_BOX:
+      return 7;
+    case OP_RECT_FILL:
+      return 10;
+    case OP_CHAR:
+      return 6;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Area a recorded call may draw on
+ *
+ * @param op Pointer to the opcode of the call
+ * @return Inclusive bounding box
+ */
+static SSD1353Rect bounds(const uint8_t* op) {
+  const uint8_t* args = op + 1;
+  if ((op[0] & ~OP_DROPPED) == OP_CHAR) {
+    // 5x7 glyph
+    SSD1353Rect r = {args[0], args[1], (uint8_t)min(args[0] + 4, 0xFF), (uint8_t)min(args[1] + 6, 0xFF)};
+    return r;
+  }
+  SSD1353Rect r = {min(args[0], args[2]), min(args[1], args[3]), max(args[0], args[2]), max(args[1], args[3])};
+  return r;
+}
+
+static bool overlaps(const SSD1353Rect& a, const SSD1353Rect& b) {
+  return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+static bool contains(const SSD1353Rect& outer, const SSD1353Rect& inner) {
+  return outer.x0 <= inner.x0 && outer.y0 <= inner.y0 && outer.x1 >= inner.x1 && outer.y1 >= inner.y1;
+}
+
+/**
+ * @brief Fill setting a recorded call needs
+ *
+ * @param op Pointer to the opcode of the call
+ * @return MODE_ANY, MODE_OUTLINE or MODE_FILL
+ */
+static uint8_t fillMode(const uint8_t* op) {
+  switch (op[0]) {
+    case OP_RECT:
+      return MODE_OUTLINE;
+    case OP_RECT_FILL:
+      return MODE_FILL;
+    case OP_BOX:
+      return op[1] != op[3] && op[2] != op[4] ? MODE_FILL : MODE_ANY;
+    default:
+      return MODE_ANY;
+  }
+}
+
+static void reverse(uint8_t* first, uint8_t* last) {
+  while (first < --last) {
+    uint8_t t = *first;
+    *first++  = *last;
+    *last     = t;
+  }
+}
+
+/**
+ * @brief Construct a display list
+ *
+ * @param buffer Buffer for the recorded calls, 7-11 bytes per call
+ * @param size Buffer size in bytes
+ */
+SSD1353DisplayList::SSD1353DisplayList(uint8_t* buffer, uint16_t size)
+    : _buffer(buffer), _size(size) {}
+
+/**
+ * @brief Forget all recorded calls
+ *
+ */
+void SSD1353DisplayList::reset() {
+  _length     = 0;
+  _overflowed = false;
+}
+
+/**
+ * @brief Make room for one call
+ *
+ * @param opcode Call opcode
+ * @param length Number of argument bytes
+ * @return uint8_t* Pointer to the argument bytes, nullptr if the buffer is full
+ */
+uint8_t* SSD1353DisplayList::reserve(uint8_t opcode, uint8_t length) {
+  if (_length + 1 + length > _size) {
+    _overflowed = true;
+    return nullptr;
+  }
+  uint8_t* op = _buffer + _length;
+  op[0]       = opcode;
+  _length += 1 + length;
+  return op + 1;
+}
+
+/**
+ * @brief Record a rectangle
+ *
+ * @param startX Bottom left corner X coordinate
+ * @param startY Bottom left corner Y coordinate
+ * @param endX Top right corner X coordinate
+ * @param endY Top right corner Y coordinate
+ * @param lineRed Border line red color value
+ * @param lineGreen Border line green color value
+ * @param lineBlue Border line blue color value
+ * @param fillRed Rectangle fill red color value
+ * @param fillGreen Rectangle fill green color value
+ * @param fillBlue Rectangle fill blue color value
+ * @param useFill Fill the rectangle, true/false
+ */
+void SSD1353DisplayList::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  uint8_t opcode = useFill ? OP_RECT_FILL : OP_RECT;
+  uint8_t* args  = reserve(opcode, argLength(opcode));
+  if (!args)
+    return;
+
+  args[0] = startX;
+  args[1] = startY;
+  args[2] = endX;
+  args[3] = endY;
+  args[4] = lineRed;
+  args[5] = lineGreen;
+  args[6] = lineBlue;
+  if (useFill) {
+    args[7] = fillRed;
+    args[8] = fillGreen;
+    args[9] = fillBlue;
+  }
+}
+
+/**
+ * @brief Record a line
+ *
+ * @param startX Starting point X coordinate
+ * @param startY Starting point Y coordinate
+ * @param endX Ending point X coordinate
+ * @param endY Ending point Y coordinate
+ * @param lineRed Line red color value
+ * @param lineGreen Line green color  value
+ * @param lineBlue Line blue color value
+ */
+void SSD1353DisplayList::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) {
+  uint8_t* args = reserve(OP_LINE, argLength(OP_LINE));
+  if (!args)
+    return;
+
+  args[0] = startX;
+  args[1] = startY;
+  args[2] = endX;
+  args[3] = endY;
+  args[4] = lineRed;
+  args[5] = lineGreen;
+  args[6] = lineBlue;
+}
+
+/**
+ * @brief Record a character
+ *
+ * @param x Character bottom left corner X coordinate
+ * @param y Character bottom left corner Y coordinate
+ * @param character Character to  be printed
+ * @param valueRed Character red color value
+ * @param valueGreen Character green color value
+ * @param valueBlue Character blue color value
+ */
+void SSD1353DisplayList::printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue) {
+  uint8_t* args = reserve(OP_CHAR, argLength(OP_CHAR));
+  if (!args)
+    return;
+
+  args[0] = x;
+  args[1] = y;
+  args[2] = character;
+  args[3] = valueRed;
+  args[4] = valueGreen;
+  args[5] = valueBlue;
+}
+
+/**
+ * @brief Rewrite the recorded calls into a cheaper list for the same picture
+ *
+ * Horizontal and vertical lines, dots and solid rectangles become boxes,
+ * calls hidden under a later solid rectangle are dropped, touching boxes
+ * of one color are merged into longer lines and filled rectangles, and
+ * rectangles are grouped so the display's fill setting changes less often.
+ * Calls are only moved past calls they do not overlap.
+ */
+void SSD1353DisplayList::optimize() {
+  makeBoxes();
+  dropCovered();
+  for (uint8_t pass = 0; pass < 8 && mergeBoxes(); pass++)
+    ;
+  groupFillModes();
+}
+
+/**
+ * @brief Remove the dropped calls from the buffer
+ *
+ */
+void SSD1353DisplayList::compact() {
+  uint16_t out = 0;
+  for (uint16_t i = 0; i < _length;) {
+    uint8_t length = 1 + argLength(_buffer[i]);
+    if (!(_buffer[i] & OP_DROPPED)) {
+      memmove(_buffer + out, _buffer + i, length);
+      out += length;
+    }
+    i += length;
+  }
+  _length = out;
+}
+
+/**
+ * @brief Turn every call that paints a solid rectangle of one color into a box
+ *
+ * The calls never grow, so the buffer is rewritten front to back in place.
+ */
+void SSD1353DisplayList::makeBoxes() {
+  uint16_t out = 0;
+  for (uint16_t i = 0; i < _length;) {
+    uint8_t op[11];
+    uint8_t length = 1 + argLength(_buffer[i]);
+    memcpy(op, _buffer + i, length);
+    i += length;
+
+    SSD1353Rect r  = bounds(op);
+    bool straight  = r.x0 == r.x1 || r.y0 == r.y1;
+    bool thin      = r.x1 - r.x0 < 2 || r.y1 - r.y0 < 2;
+    bool sameColor = op[0] == OP_RECT_FILL && op[5] == op[8] && op[6] == op[9] && op[7] == op[10];
+    if ((op[0] == OP_LINE && straight) || (op[0] == OP_RECT && thin) || (op[0] == OP_RECT_FILL && (sameColor || thin))) {
+      // A thin filled rectangle is all border
+      op[0]  = OP_BOX;
+      op[1]  = r.x0;
+      op[2]  = r.y0;
+      op[3]  = r.x1;
+      op[4]  = r.y1;
+      length = 1 + argLength(OP_BOX);
+    }
+    memcpy(_buffer + out, op, length);
+    out += length;
+  }
+  _length = out;
+}
+
+/**
+ * @brief Drop calls that a later solid rectangle paints over completely
+ *
+ */
+void SSD1353DisplayList::dropCovered() {
+  for (uint16_t i = 0; i < _length; i += 1 + argLength(_buffer[i])) {
+    SSD1353Rect r = bounds(_buffer + i);
+    for (uint16_t j = i + 1 + argLength(_buffer[i]); j < _length; j += 1 + argLength(_buffer[j])) {
+      uint8_t opcode = _buffer[j] & ~OP_DROPPED;
+      if ((opcode == OP_BOX || opcode == OP_RECT_FILL) && contains(bounds(_buffer + j), r)) {
+        _buffer[i] |= OP_DROPPED;
+        break;
+      }
+    }
+  }
+  compact();
+}
+
+/**
+ * @brief Merge each box into an earlier box of the same color it touches
+ *
+ * The two must join into a rectangle, and no call in between may overlap
+ * the later box, as its pixels are drawn earlier after the merge.
+ *
+ * @return A box was merged, true/false
+ */
+bool SSD1353DisplayList::mergeBoxes() {
+  uint16_t recent[SSD1353_OPTIMIZE_WINDOW];
+  uint8_t count = 0;
+  bool merged   = false;
+
+  for (uint16_t i = 0; i < _length; i += 1 + argLength(_buffer[i])) {
+    uint8_t* b = _buffer + i;
+    if (b[0] == OP_BOX) {
+      for (uint8_t k = count; k-- > 0;) {
+        uint8_t* a = _buffer + recent[k];
+        if (a[0] & OP_DROPPED)
+          continue;
+
+        SSD1353Rect ra = bounds(a), rb = bounds(b);
+        bool sameColor = a[0] == OP_BOX && a[5] == b[5] && a[6] == b[6] && a[7] == b[7];
+        bool columns   = ra.x0 == rb.x0 && ra.x1 == rb.x1 && ra.y0 <= rb.y1 + 1 && rb.y0 <= ra.y1 + 1;
+        bool rows      = ra.y0 == rb.y0 && ra.y1 == rb.y1 && ra.x0 <= rb.x1 + 1 && rb.x0 <= ra.x1 + 1;
+        if (sameColor && (columns || rows || contains(ra, rb) || contains(rb, ra))) {
+          a[1] = min(ra.x0, rb.x0);
+          a[2] = min(ra.y0, rb.y0);
+          a[3] = max(ra.x1, rb.x1);
+          a[4] = max(ra.y1, rb.y1);
+          b[0] |= OP_DROPPED;
+          merged = true;
+          break;
+        }
+        if (overlaps(ra, rb))
+          break;
+      }
+    }
+
+    if (b[0] & OP_DROPPED)
+      continue;
+    if (count == SSD1353_OPTIMIZE_WINDOW) {
+      memmove(recent, recent + 1, sizeof(recent) - sizeof(recent[0]));
+      count--;
+    }
+    recent[count++] = i;
+  }
+  compact();
+  return merged;
+}
+
+/**
+ * @brief Reorder rectangles so the fill setting changes less often
+ *
+ * When the next call needs the other fill setting, a later call that needs
+ * the current one is moved in front of it, if it overlaps nothing it would
+ * move past.
+ */
+void SSD1353DisplayList::groupFillModes() {
+  uint8_t mode = MODE_ANY;
+
+  for (uint16_t p = 0; p < _length; p += 1 + argLength(_buffer[p])) {
+    uint8_t next = fillMode(_buffer + p);
+    if (mode != MODE_ANY && next != MODE_ANY && next != mode) {
+      uint16_t q = p;
+      for (uint8_t n = 0; n < SSD1353_OPTIMIZE_WINDOW; n++) {
+        q += 1 + argLength(_buffer[q]);
+        if (q >= _length)
+          break;
+        if (fillMode(_buffer + q) != mode)
+          continue;
+
+        SSD1353Rect r = bounds(_buffer + q);
+        bool free     = true;
+        for (uint16_t j = p; j < q && free; j += 1 + argLength(_buffer[j]))
+          free = !overlaps(bounds(_buffer + j), r);
+        if (free) {
+          // Rotate the call at q to position p
+          uint8_t* end = _buffer + q + 1 + argLength(_buffer[q]);
+          reverse(_buffer + p, _buffer + q);
+          reverse(_buffer + q, end);
+          reverse(_buffer + p, end);
+          break;
+        }
+      }
+      next = fillMode(_buffer + p);
+    }
+    if (next != MODE_ANY)
+      mode = next;
+  }
+}
+
+/**
+ * @brief Replay the recorded calls on another drawing surface
+ *
+ * @param target Surface to draw on
+ * @param minY Calls entirely below this row are skipped
+ * @param maxY Calls entirely above this row are skipped
+ */
+void SSD1353DisplayList::replay(SSD1353Gfx& target, uint8_t minY, uint8_t maxY) const {
+  for (uint16_t i = 0; i < _length; i += 1 + argLength(_buffer[i])) {
+    const uint8_t* args = _buffer + i + 1;
+    uint8_t opcode      = _buffer[i];
+
+    // Vertical extent of the call
+    uint8_t y0 = args[1];
+    uint8_t y1 = opcode == OP_CHAR ? (uint8_t)min(args[1] + 6, 0xFF) : args[3];
+    if (y0 > y1) {
+      uint8_t t = y0;
+      y0        = y1;
+      y1        = t;
+    }
+    if (y1 < minY || y0 > maxY)
+      continue;
+
+    switch (opcode) {
+      case OP_LINE:
+        target.drawLine(args[0], args[1], args[2], args[3], args[4], args[5], args[6]);
+        break;
+
+      case OP_RECT:
+        target.drawRectangle(args[0], args[1], args[2], args[3], args[4], args[5], args[6], 0, 0, 0, false);
+        break;
+
+      case OP_RECT_FILL:
+        target.drawRectangle(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9], true);
+        break;
+
+      case OP_CHAR:
+        target.printchar(args[0], args[1], args[2], args[3], args[4], args[5]);
+        break;
+
+      case OP_BOX:
+        if (args[0] == args[2] || args[1] == args[3])
+          target.drawLine(args[0], args[1], args[2], args[3], args[4], args[5], args[6]);
+        else
+          target.drawRectangle(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[4], args[5], args[6], true);
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Render the recorded frame one horizontal strip at a time
+ *
+ * The strip canvas is moved down the display from row 0, the calls
+ * touching it are drawn into it and it is sent to the display, so a
+ * full frame needs only the strip's worth of RAM.
+ *
+ * @param display Target display
+ * @param strip Canvas used as the strip buffer, its X origin and width select the columns
+ * @param background RGB565 color of pixels no call draws on
+ */
+void SSD1353DisplayList::renderBands(SSD1353Base& display, SSD1353Canvas& strip, uint16_t background) const {
+  uint8_t x = strip.originX();
+
+  display.beginWrite();
+  for (uint16_t y = 0; y < SSD1353_HEIGHT; y += strip.height()) {
+    strip.setOrigin(x, y);
+    strip.fillRect(x, y, x + strip.width() - 1, y + strip.height() - 1, background);
+    replay(strip, y, min(y + strip.height() - 1, SSD1353_HEIGHT - 1));
+
+    // The last strip may hang off the top of the display
+    SSD1353Rect area = {x, (uint8_t)y, (uint8_t)(x + strip.width() - 1), (uint8_t)min(y + strip.height() - 1, SSD1353_HEIGHT - 1)};
+    strip.flush(display, area);
+  }
+  display.endWrite();
+}
@@ -0,0 +1,62 @@
+/*
+  SSD1353DisplayList.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353DISPLAYLIST_H
+#define SSD1353DISPLAYLIST_H
+
+#include "SSD1353.h"
+#include "SSD1353Canvas.h"
+
+// Number of earlier calls optimize() looks back over when merging and
+// ahead over when reordering
+#ifndef SSD1353_OPTIMIZE_WINDOW
+#define SSD1353_OPTIMIZE_WINDOW 16
+#endif
+
+// Records drawing calls into a caller supplied buffer for later replay
+class SSD1353DisplayList : public SSD1353Gfx {
+  public:
+  SSD1353DisplayList(uint8_t* buffer, uint16_t size);
+
+  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue);
+  using SSD1353Gfx::drawRectangle;
+  using SSD1353Gfx::drawLine;
+  using SSD1353Gfx::printchar;
+  void printchar(uint8_t x, uint8_t y, char character, uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue);
+
+  void reset();
+  void optimize();
+  void replay(SSD1353Gfx& target, uint8_t minY = 0, uint8_t maxY = 0xFF) const;
+  void renderBands(SSD1353Base& display, SSD1353Canvas& strip, uint16_t background = 0) const;
+
+  uint16_t length() const { return _length; }
+  bool overflowed() const { return _overflowed; }
+
+  private:
+  uint8_t* _buffer;
+  uint16_t _size;
+  uint16_t _length = 0;
+  bool _overflowed = false;
+
+  uint8_t* reserve(uint8_t opcode, uint8_t length);
+  void compact();
+  void makeBoxes();
+  void dropCovered();
+  bool mergeBoxes();
+  void groupFillModes();
+};
+
+#endif
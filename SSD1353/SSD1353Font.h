@@ -0,0 +1,138 @@
+/*
+  SSD1353Font.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353FONT_H
+#define SSD1353FONT_H
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#define SSD1353_FONT_FIRST  ' '
+#define SSD1353_FONT_LAST   '~'
+#define SSD1353_FONT_WIDTH  5
+#define SSD1353_FONT_HEIGHT 7
+
+// 5x7 glyphs for ' ' to '~', then the glyph used for any other character.
+// One byte per column from left to right, bit 0 is the bottom row.
+static constexpr uint8_t ssd1353Font[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x7D, 0x00, 0x00, // '!'
+    0x00, 0x60, 0x00, 0x60, 0x00, // '"'
+    0x14, 0x7F, 0x14, 0x7F, 0x14, // '#'
+    0x12, 0x2A, 0x7F, 0x2A, 0x24, // '$'
+    0x62, 0x64, 0x08, 0x13, 0x23, // '%'
+    0x36, 0x49, 0x35, 0x02, 0x05, // '&'
+    0x00, 0x00, 0x60, 0x00, 0x00, // '\''
+    0x00, 0x00, 0x3E, 0x41, 0x00, // '('
+    0x00, 0x41, 0x3E, 0x00, 0x00, // ')'
+    0x2A, 0x1C, 0x3E, 0x1C, 0x2A, // '*'
+    0x08, 0x08, 0x3E, 0x08, 0x08, // '+'
+    0x00, 0x01, 0x06, 0x00, 0x00, // ','
+    0x08, 0x08, 0x08, 0x08, 0x08, // '-'
+    0x00, 0x00, 0x01, 0x00, 0x00, // '.'
+    0x01, 0x06, 0x08, 0x30, 0x40, // '/'
+    0x3E, 0x45, 0x49, 0x51, 0x3E, // '0'
+    0x11, 0x21, 0x7F, 0x01, 0x01, // '1'
+    0x23, 0x45, 0x49, 0x49, 0x31, // '2'
+    0x22, 0x41, 0x49, 0x49, 0x36, // '3'
+    0x0C, 0x14, 0x24, 0x7F, 0x04, // '4'
+    0x72, 0x51, 0x51, 0x51, 0x4E, // '5'
+    0x3E, 0x49, 0x49, 0x49, 0x26, // '6'
+    0x40, 0x40, 0x4F, 0x50, 0x60, // '7'
+    0x36, 0x49, 0x49, 0x49, 0x36, // '8'
+    0x32, 0x49, 0x49, 0x49, 0x3E, // '9'
+    0x00, 0x00, 0x36, 0x00, 0x00, // ':'
+    0x00, 0x01, 0x36, 0x00, 0x00, // ';'
+    0x08, 0x14, 0x22, 0x41, 0x00, // '<'
+    0x14, 0x14, 0x14, 0x14, 0x14, // '='
+    0x00, 0x41, 0x22, 0x14, 0x08, // '>'
+    0x20, 0x40, 0x45, 0x48, 0x30, // '?'
+    0x3E, 0x41, 0x5D, 0x55, 0x38, // '@'
+    0x3F, 0x44, 0x44, 0x44, 0x3F, // 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36, // 'B'
+    0x3E, 0x41, 0x41, 0x41, 0x22, // 'C'
+    0x7F, 0x41, 0x41, 0x41, 0x3E, // 'D'
+    0x7F, 0x49, 0x49, 0x49, 0x41, // 'E'
+    0x7F, 0x48, 0x48, 0x48, 0x40, // 'F'
+    0x3E, 0x41, 0x49, 0x49, 0x2E, // 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F, // 'H'
+    0x00, 0x00, 0x7F, 0x00, 0x00, // 'I'
+    0x02, 0x01, 0x01, 0x7E, 0x00, // 'J'
+    0x7F, 0x08, 0x08, 0x14, 0x63, // 'K'
+    0x7F, 0x01, 0x01, 0x01, 0x01, // 'L'
+    0x7F, 0x20, 0x18, 0x20, 0x7F, // 'M'
+    0x7F, 0x10, 0x08, 0x04, 0x7F, // 'N'
+    0x3E, 0x41, 0x41, 0x41, 0x3E, // 'O'
+    0x7F, 0x48, 0x48, 0x48, 0x30, // 'P'
+    0x3E, 0x41, 0x45, 0x43, 0x3F, // 'Q'
+    0x7F, 0x48, 0x48, 0x48, 0x37, // 'R'
+    0x31, 0x49, 0x49, 0x49, 0x46, // 'S'
+    0x40, 0x40, 0x7F, 0x40, 0x40, // 'T'
+    0x7E, 0x01, 0x01, 0x01, 0x7E, // 'U'
+    0x7C, 0x02, 0x01, 0x02, 0x7C, // 'V'
+    0x7F, 0x02, 0x0C, 0x02, 0x7F, // 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63, // 'X'
+    0x60, 0x10, 0x0F, 0x10, 0x60, // 'Y'
+    0x43, 0x45, 0x49, 0x51, 0x61, // 'Z'
+    0x00, 0x00, 0x7F, 0x41, 0x00, // '['
+    0x40, 0x30, 0x08, 0x06, 0x01, // '\\'
+    0x00, 0x41, 0x7F, 0x00, 0x00, // ']'
+    0x10, 0x20, 0x40, 0x20, 0x10, // '^'
+    0x01, 0x01, 0x01, 0x01, 0x01, // '_'
+    0x7F, 0x41, 0x41, 0x41, 0x7F, // '`'
+    0x02, 0x15, 0x15, 0x15, 0x0F, // 'a'
+    0x7F, 0x09, 0x09, 0x09, 0x06, // 'b'
+    0x0E, 0x11, 0x11, 0x11, 0x0A, // 'c'
+    0x06, 0x09, 0x09, 0x09, 0x7F, // 'd'
+    0x0E, 0x15, 0x15, 0x15, 0x0D, // 'e'
+    0x08, 0x3F, 0x48, 0x40, 0x20, // 'f'
+    0x08, 0x15, 0x15, 0x15, 0x0E, // 'g'
+    0x7F, 0x08, 0x08, 0x08, 0x07, // 'h'
+    0x00, 0x11, 0x5F, 0x01, 0x00, // 'i'
+    0x02, 0x01, 0x11, 0x5E, 0x00, // 'j'
+    0x7F, 0x04, 0x04, 0x0A, 0x11, // 'k'
+    0x00, 0x41, 0x7F, 0x01, 0x00, // 'l'
+    0x1F, 0x10, 0x1F, 0x10, 0x0F, // 'm'
+    0x1F, 0x10, 0x10, 0x10, 0x0F, // 'n'
+    0x0E, 0x11, 0x11, 0x11, 0x0E, // 'o'
+    0x00, 0x1F, 0x14, 0x14, 0x08, // 'p'
+    0x08, 0x14, 0x14, 0x1F, 0x00, // 'q'
+    0x1F, 0x08, 0x10, 0x10, 0x10, // 'r'
+    0x09, 0x15, 0x15, 0x15, 0x12, // 's'
+    0x00, 0x10, 0x7E, 0x11, 0x01, // 't'
+    0x1E, 0x01, 0x01, 0x02, 0x1F, // 'u'
+    0x1C, 0x02, 0x01, 0x02, 0x1C, // 'v'
+    0x1F, 0x02, 0x07, 0x02, 0x1F, // 'w'
+    0x11, 0x0A, 0x04, 0x0A, 0x11, // 'x'
+    0x19, 0x05, 0x05, 0x05, 0x1E, // 'y'
+    0x11, 0x13, 0x15, 0x19, 0x11, // 'z'
+    0x00, 0x08, 0x36, 0x41, 0x00, // '{'
+    0x00, 0x00, 0x7F, 0x00, 0x00, // '|'
+    0x00, 0x41, 0x36, 0x08, 0x00, // '}'
+    0x08, 0x10, 0x08, 0x04, 0x08, // '~'
+    0x7F, 0x41, 0x41, 0x41, 0x7F  // Unknown character
+};
+
+/**
+ * @brief Offset of a character's glyph in ssd1353Font
+ *
+ * @param character Character to look up
+ * @return Index of the first column byte
+ */
+static constexpr uint16_t ssd1353Glyph(char character) {
+  return (character >= SSD1353_FONT_FIRST && character <= SSD1353_FONT_LAST ? character - SSD1353_FONT_FIRST : SSD1353_FONT_LAST - SSD1353_FONT_FIRST + 1) * SSD1353_FONT_WIDTH;
+}
+
+#endif
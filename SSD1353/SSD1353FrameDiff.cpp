@@ -0,0 +1,220 @@
+/*
+  SSD1353FrameDiff.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353FrameDiff.h"
+#include <Arduino.h>
+
+// Bus bytes of each way to send something
+#define COST_WINDOW    7  // Column, row and RAM write commands
+#define COST_RECTANGLE 11
+#define COST_LINE      8
+
+/**
+ * @brief Update the display from the previous frame to the next
+ *
+ * The display is expected to show the previous frame. If the canvases
+ * cover different areas the whole next frame is sent.
+ *
+ * @param previous Frame on the display now
+ * @param next Frame to show
+ * @return Bus bytes sent, not counting fill mode changes
+ */
+uint32_t SSD1353FrameDiff::update(const SSD1353Canvas& previous, SSD1353Canvas& next) {
+  _bytes     = 0;
+  _openCount = 0;
+  _originX   = next.originX();
+  _originY   = next.originY();
+
+  if (previous.width() != next.width() || previous.height() != next.height() || previous.originX() != next.originX() || previous.originY() != next.originY()) {
+    next.flush(_display);
+    return COST_WINDOW + (uint32_t)next.width() * next.height() * (_display.colorDepth() == SSD1353_COLOR_65K ? 2 : 3);
+  }
+
+  const uint16_t* before = previous.buffer();
+  const uint16_t* after  = next.buffer();
+  uint8_t width          = next.width();
+
+  _display.beginWrite();
+  for (uint16_t top = 0; top < next.height(); top += SSD1353_DIFF_BAND) {
+    uint8_t bottom = min(top + SSD1353_DIFF_BAND, next.height()) - 1;
+
+    // Columns with a change anywhere in the band, and the rows changed.
+    // Sized for any canvas width, a canvas may be wider than the display.
+    uint8_t changed[(0xFF + 7) / 8] = {0};
+    uint8_t first = 0xFF, last = 0;
+    for (uint8_t y = top; y <= bottom; y++) {
+      for (uint8_t x = 0; x < width; x++) {
+        uint16_t i = (uint16_t)y * width + x;
+        if (before[i] == after[i])
+          continue;
+        changed[x / 8] |= 1 << (x % 8);
+        first = min(first, y);
+        last  = max(last, y);
+      }
+    }
+
+    // Every run of changed columns is a region
+    for (uint8_t x = 0; first != 0xFF && x < width; x++) {
+      if (!((changed[x / 8] >> (x % 8)) & 1))
+        continue;
+      uint8_t end = x;
+      while (end + 1 < width && ((changed[(end + 1) / 8] >> ((end + 1) % 8)) & 1))
+        end++;
+      SSD1353Rect region = {x, first, end, last};
+      sendRegion(previous, next, region);
+      x = end;
+    }
+
+    // Commands not reaching the band's last row cannot grow any more
+    sendOpen(bottom);
+  }
+  while (_openCount)
+    send(0);
+  _display.endWrite();
+
+  return _bytes;
+}
+
+/**
+ * @brief Estimated time of a fill or line command in nanoseconds
+ *
+ * @param run Area the command covers
+ * @return Bus time plus drawing engine time
+ */
+uint32_t SSD1353FrameDiff::commandCost(const Run& run) const {
+  uint16_t width  = run.x1 - run.x0 + 1;
+  uint16_t height = run.y1 - run.y0 + 1;
+  if (width == 1 || height == 1)
+    return COST_LINE * _display.busByteNanos() + (uint32_t)(width + height - 1) * _display.accelNanos();
+  return COST_RECTANGLE * _display.busByteNanos() + _display.accelBase() * 1000UL + (uint32_t)width * height * _display.accelNanos();
+}
+
+/**
+ * @brief Send one changed region in whichever way is cheaper
+ *
+ * The region is broken into runs of one color per row, runs that repeat
+ * the row above grow into rectangles. Only runs covering a change are
+ * needed. If they cost more than writing the region's pixels, or there
+ * are too many, the pixels are written instead.
+ *
+ * @param previous Frame on the display now
+ * @param next Frame to show
+ * @param region Changed region in canvas coordinates
+ */
+void SSD1353FrameDiff::sendRegion(const SSD1353Canvas& previous, SSD1353Canvas& next, const SSD1353Rect& region) {
+  const uint16_t* before = previous.buffer();
+  const uint16_t* after  = next.buffer();
+  uint8_t width          = next.width();
+  uint8_t size           = _display.colorDepth() == SSD1353_COLOR_65K ? 2 : 3;
+
+  uint32_t windowBytes = COST_WINDOW + (uint32_t)(region.x1 - region.x0 + 1) * (region.y1 - region.y0 + 1) * size;
+  uint32_t windowCost  = windowBytes * _display.busByteNanos();
+
+  Run runs[SSD1353_DIFF_COMMANDS];
+  uint8_t count = 0;
+  bool pixels   = false;
+  for (uint8_t y = region.y0; y <= region.y1 && !pixels; y++) {
+    const uint16_t* row = after + (uint16_t)y * width;
+    for (uint8_t x = region.x0; x <= region.x1 && !pixels;) {
+      uint8_t end  = x;
+      bool differs = row[x] != before[(uint16_t)y * width + x];
+      while (end < region.x1 && row[end + 1] == row[x]) {
+        end++;
+        differs |= row[end] != before[(uint16_t)y * width + end];
+      }
+
+      if (differs) {
+        uint8_t i = 0;
+        while (i < count && !(runs[i].y1 + 1 == y && runs[i].x0 == x && runs[i].x1 == end && runs[i].color == row[x]))
+          i++;
+        if (i < count)
+          runs[i].y1 = y;
+        else if (count < SSD1353_DIFF_COMMANDS)
+          runs[count++] = {x, end, y, y, row[x]};
+        else
+          pixels = true;
+      }
+      x = end + 1;
+    }
+  }
+
+  uint32_t commandsCost = 0;
+  for (uint8_t i = 0; i < count && !pixels; i++) {
+    commandsCost += commandCost(runs[i]);
+    pixels = commandsCost >= windowCost;
+  }
+
+  if (pixels) {
+    SSD1353Rect area = {(uint8_t)(region.x0 + next.originX()), (uint8_t)(region.y0 + next.originY()), (uint8_t)(region.x1 + next.originX()), (uint8_t)(region.y1 + next.originY())};
+    next.flush(_display, area);
+    _bytes += windowBytes;
+    return;
+  }
+  for (uint8_t i = 0; i < count; i++)
+    keep(runs[i]);
+}
+
+/**
+ * @brief Hold a chosen command back in case the next band continues it
+ *
+ * @param run Command area in canvas coordinates
+ */
+void SSD1353FrameDiff::keep(const Run& run) {
+  for (uint8_t i = 0; i < _openCount; i++) {
+    Run& open = _open[i];
+    if (open.y1 + 1 == run.y0 && open.x0 == run.x0 && open.x1 == run.x1 && open.color == run.color) {
+      open.y1 = run.y1;
+      return;
+    }
+  }
+
+  if (_openCount == SSD1353_DIFF_COMMANDS)
+    send(0);
+  _open[_openCount++] = run;
+}
+
+/**
+ * @brief Send a held command as a line or a rectangle fill
+ *
+ * @param i Index of the held command
+ */
+void SSD1353FrameDiff::send(uint8_t i) {
+  Run run  = _open[i];
+  _open[i] = _open[--_openCount];
+
+  Color565 color(run.color);
+  uint8_t x0 = run.x0 + _originX, y0 = run.y0 + _originY, x1 = run.x1 + _originX, y1 = run.y1 + _originY;
+  if (x0 == x1 || y0 == y1) {
+    _display.drawLine(x0, y0, x1, y1, color);
+    _bytes += COST_LINE;
+  } else {
+    _display.drawRectangle(x0, y0, x1, y1, color, color, true);
+    _bytes += COST_RECTANGLE;
+  }
+}
+
+/**
+ * @brief Send the held commands that end above a row
+ *
+ * @param lastRow Last row of the band just compared
+ */
+void SSD1353FrameDiff::sendOpen(uint8_t lastRow) {
+  for (uint8_t i = 0; i < _openCount;) {
+    if (_open[i].y1 < lastRow)
+      send(i);
+    else
+      i++;
+  }
+}
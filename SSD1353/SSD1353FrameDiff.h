@@ -0,0 +1,70 @@
+/*
+  SSD1353FrameDiff.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353FRAMEDIFF_H
+#define SSD1353FRAMEDIFF_H
+
+#include "SSD1353.h"
+#include "SSD1353Canvas.h"
+
+// Rows compared at a time, changed columns of a band form its regions
+#ifndef SSD1353_DIFF_BAND
+#define SSD1353_DIFF_BAND 8
+#endif
+
+// Most fills and lines kept per region, more and it is sent as pixels
+#ifndef SSD1353_DIFF_COMMANDS
+#define SSD1353_DIFF_COMMANDS 32
+#endif
+
+/**
+ * @brief Sends the difference between two frames with the cheapest commands
+ *
+ * Each changed region is either written as a pixel window or broken into
+ * runs of one color sent as rectangle fills and lines, whichever the cost
+ * model of the display's bus says is faster.
+ */
+class SSD1353FrameDiff {
+  public:
+  SSD1353FrameDiff(SSD1353Base& display)
+      : _display(display) {}
+
+  uint32_t update(const SSD1353Canvas& previous, SSD1353Canvas& next);
+
+  private:
+  // Run of one color, grown downwards while the rows below repeat it
+  struct Run {
+    uint8_t x0,
+        x1,
+        y0,
+        y1;
+    uint16_t color;
+  };
+
+  SSD1353Base& _display;
+  Run _open[SSD1353_DIFF_COMMANDS]; // Chosen commands that may still grow into the next band
+  uint8_t _openCount,
+      _originX,
+      _originY;
+  uint32_t _bytes;
+
+  uint32_t commandCost(const Run& run) const;
+  void sendRegion(const SSD1353Canvas& previous, SSD1353Canvas& next, const SSD1353Rect& region);
+  void keep(const Run& run);
+  void send(uint8_t i);
+  void sendOpen(uint8_t lastRow);
+};
+
+#endif
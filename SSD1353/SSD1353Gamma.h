@@ -0,0 +1,93 @@
+/*
+  SSD1353Gamma.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353GAMMA_H
+#define SSD1353GAMMA_H
+
+#include "SSD1353.h"
+
+// Compile-time grayscale tables for SSD1353Base::setGammaTable().
+//
+// Entry i - 1 is the drive pulse width of gray level i out of 63, which
+// follows SSD1353_GAMMA_MAX * (i / 63) ^ gamma. The controller wants the
+// widths to rise strictly, flat stretches at the dark end are stepped up
+// by one. The math is C++11 constexpr, only the tables reach flash.
+
+namespace SSD1353Gamma {
+  struct Table {
+    uint8_t data[SSD1353_GAMMA_ENTRIES];
+  };
+
+  constexpr double LN2 = 0.69314718055994531;
+
+  // ln(x) for x in [0.5, 1) from the atanh series of z = (x - 1) / (x + 1)
+  constexpr double lnSeries(double z, double zz, double term, int k) {
+    return k > 31 ? 0 : term / k + lnSeries(z, zz, term * zz, k + 2);
+  }
+
+  constexpr double ln(double x) {
+    return x < 0.5 ? ln(x * 2) - LN2 : 2 * lnSeries((x - 1) / (x + 1), ((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), (x - 1) / (x + 1), 1);
+  }
+
+  constexpr double expSeries(double y, double term, int k) {
+    return k > 16 ? 0 : term + expSeries(y, term * y / k, k + 1);
+  }
+
+  constexpr double square(double x) { return x * x; }
+
+  // exp(y), halved until the series converges quickly
+  constexpr double exp(double y) {
+    return y < -0.5 || y > 0.5 ? square(exp(y / 2)) : expSeries(y, 1, 1);
+  }
+
+  constexpr uint8_t curve(uint8_t gamma10, uint8_t level) {
+    return (uint8_t)(SSD1353_GAMMA_MAX * exp(gamma10 / 10.0 * ln(level / (double)SSD1353_GAMMA_ENTRIES)) + 0.5);
+  }
+
+  constexpr uint8_t stepUp(uint8_t width, uint8_t previous) { return width > previous ? width : previous + 1; }
+
+  constexpr uint8_t entry(uint8_t gamma10, uint8_t level) {
+    return stepUp(curve(gamma10, level), level == 1 ? 0 : entry(gamma10, level - 1));
+  }
+
+  template <int... Is>
+  struct Seq {};
+
+  template <int N, int... Is>
+  struct MakeSeq : MakeSeq<N - 1, N - 1, Is...> {};
+
+  template <int... Is>
+  struct MakeSeq<0, Is...> {
+    typedef Seq<Is...> type;
+  };
+
+  template <int... Is>
+  constexpr Table build(uint8_t gamma10, Seq<Is...>) {
+    return Table{{entry(gamma10, Is + 1)...}};
+  }
+
+  // Table for a gamma of gamma10 / 10
+  template <uint8_t Gamma10>
+  constexpr Table table() {
+    return build(Gamma10, MakeSeq<SSD1353_GAMMA_ENTRIES>::type());
+  }
+} // namespace SSD1353Gamma
+
+static constexpr SSD1353Gamma::Table ssd1353GammaLinear PROGMEM = SSD1353Gamma::table<10>();
+static constexpr SSD1353Gamma::Table ssd1353Gamma18 PROGMEM     = SSD1353Gamma::table<18>();
+static constexpr SSD1353Gamma::Table ssd1353Gamma22 PROGMEM     = SSD1353Gamma::table<22>();
+static constexpr SSD1353Gamma::Table ssd1353Gamma25 PROGMEM     = SSD1353Gamma::table<25>();
+
+#endif
@@ -0,0 +1,237 @@
+/*
+  SSD1353Group.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Group.h"
+#include <Arduino.h>
+
+/**
+ * @brief Set up the pins shared by all panels of the group
+ *
+ * @param pinDC Display pin DC
+ * @param pinRS Display pin RS
+ * @param pinD0 Display pin D0
+ * @param pinD1 Display pin D1
+ * @param pinD2 Display pin D2
+ * @param pinD3 Display pin D3
+ * @param pinD4 Display pin D4
+ * @param pinD5 Display pin D5
+ * @param pinD6 Display pin D6
+ * @param pinD7 Display pin D7
+ */
+void SSD1353Group::init(uint8_t pinDC, uint8_t pinRS, uint8_t pinD0, uint8_t pinD1, uint8_t pinD2, uint8_t pinD3, uint8_t pinD4, uint8_t pinD5, uint8_t pinD6, uint8_t pinD7) {
+  const uint8_t pinD[] = {pinD0, pinD1, pinD2, pinD3, pinD4, pinD5, pinD6, pinD7};
+  _pinRS               = pinRS;
+
+  pinMode(_pinRS, OUTPUT);
+  digitalWrite(_pinRS, HIGH);
+  _bus.init(pinDC, pinD);
+}
+
+/**
+ * @brief Add a panel to the group
+ *
+ * @param panel Panel to add, drawn on alone afterwards
+ * @param pinCS Panel pin CS
+ * @param pinDISF Panel pin DISF
+ * @return true on success, false if the group is full
+ */
+bool SSD1353Group::addPanel(SSD1353Panel& panel, uint8_t pinCS, uint8_t pinDISF) {
+  if (_panelCount == SSD1353_GROUP_PANELS)
+    return false;
+
+  panel._group   = this;
+  panel._pinCS   = pinCS;
+  panel._pinDISF = pinDISF;
+  pinMode(pinCS, OUTPUT);
+  pinMode(pinDISF, OUTPUT);
+  digitalWrite(pinCS, HIGH);
+
+#ifdef SSD1353_FAST_BUS
+  panel._regCS  = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(pinCS));
+  panel._maskCS = digitalPinToBitMask(pinCS);
+#endif
+
+  _panels[_panelCount++] = &panel;
+  select(_selected);
+  return true;
+}
+
+/**
+ * @brief Reset all panels and set them up together
+ *
+ * The shared RS line resets every panel, the setup sequence is sent once
+ * to all of them.
+ */
+void SSD1353Group::begin() {
+  uint8_t selected = _selected;
+  select(SSD1353_GROUP_ALL);
+
+  // Display reset sequence
+  for (uint8_t p = 0; p < _panelCount; p++)
+    digitalWrite(_panels[p]->_pinDISF, LOW);
+  digitalWrite(_pinRS, LOW);
+  delay(10);
+  digitalWrite(_pinRS, HIGH);
+  delay(10);
+
+  initSequence();
+  for (uint8_t p = 0; p < _panelCount; p++) {
+    _panels[p]->colorDepthShared(colorDepth());
+    digitalWrite(_panels[p]->_pinDISF, HIGH);
+  }
+
+  select(selected);
+}
+
+/**
+ * @brief Choose the panels that drawing on the group reaches
+ *
+ * @param panels Bitmask of panel indexes in the order they were added, or SSD1353_GROUP_ALL
+ */
+void SSD1353Group::select(uint8_t panels) {
+  _selected = panels;
+
+#ifdef SSD1353_FAST_BUS
+  _selectPorts = 0;
+  for (uint8_t p = 0; p < _panelCount; p++) {
+    if (!((panels >> p) & 1))
+      continue;
+    uint8_t n = 0;
+    while (n < _selectPorts && _selectReg[n] != _panels[p]->_regCS)
+      n++;
+    if (n == _selectPorts) {
+      _selectReg[n]  = _panels[p]->_regCS;
+      _selectMask[n] = 0;
+      _selectPorts++;
+    }
+    _selectMask[n] |= _panels[p]->_maskCS;
+  }
+#endif
+}
+
+/**
+ * @brief Set the pixel format of the selected panels
+ *
+ * @param depth SSD1353_COLOR_65K or SSD1353_COLOR_262K
+ */
+void SSD1353Group::setColorDepth(uint8_t depth) {
+  SSD1353Base::setColorDepth(depth);
+  for (uint8_t p = 0; p < _panelCount; p++)
+    if ((_selected >> p) & 1)
+      _panels[p]->colorDepthShared(colorDepth());
+}
+
+/**
+ * @brief Wait until no selected panel has drawing engine work left
+ *
+ */
+void SSD1353Group::busBegin() {
+  for (uint8_t p = 0; p < _panelCount; p++)
+    if ((_selected >> p) & 1)
+      while (_panels[p]->busy())
+        ;
+}
+
+/**
+ * @brief Tell the selected panels what the broadcast changed
+ *
+ */
+void SSD1353Group::busEnd() {
+  for (uint8_t p = 0; p < _panelCount; p++)
+    if ((_selected >> p) & 1)
+      _panels[p]->commandsShared();
+}
+
+/**
+ * @brief Write data to all selected panels
+ *
+ * @param data Pointer to the bytes to be written
+ * @param length Number of bytes
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353Group::busWrite(const uint8_t* data, uint16_t length, bool isCommand) {
+  _bus.setCommand(isCommand);
+
+  // All selected CS lines rise together, every panel latches the byte
+  for (uint16_t n = 0; n < length; n++) {
+#ifdef SSD1353_FAST_BUS
+    for (uint8_t i = 0; i < _selectPorts; i++)
+      *_selectReg[i] = *_selectReg[i] & ~_selectMask[i];
+    _bus.put(data[n]);
+    for (uint8_t i = 0; i < _selectPorts; i++)
+      *_selectReg[i] = *_selectReg[i] | _selectMask[i];
+#else
+    for (uint8_t p = 0; p < _panelCount; p++)
+      if ((_selected >> p) & 1)
+        digitalWrite(_panels[p]->_pinCS, LOW);
+    _bus.put(data[n]);
+    for (uint8_t p = 0; p < _panelCount; p++)
+      if ((_selected >> p) & 1)
+        digitalWrite(_panels[p]->_pinCS, HIGH);
+#endif
+  }
+}
+
+/**
+ * @brief Set up this panel alone
+ *
+ * Only the setup sequence is sent, the reset line is shared with the
+ * rest of the group. SSD1353Group::begin() sets up all panels at once.
+ */
+void SSD1353Panel::init() {
+  digitalWrite(_pinDISF, LOW);
+  initSequence();
+  digitalWrite(_pinDISF, HIGH);
+}
+
+/**
+ * @brief Wait until the group's drawing engine work is done
+ *
+ */
+void SSD1353Panel::busBegin() {
+  while (_group->busy())
+    ;
+}
+
+/**
+ * @brief Tell the group this panel no longer matches it
+ *
+ */
+void SSD1353Panel::busEnd() {
+  _group->commandsShared();
+}
+
+/**
+ * @brief Write data to this panel
+ *
+ * @param data Pointer to the bytes to be written
+ * @param length Number of bytes
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353Panel::busWrite(const uint8_t* data, uint16_t length, bool isCommand) {
+  _group->_bus.setCommand(isCommand);
+
+  for (uint16_t n = 0; n < length; n++) {
+#ifdef SSD1353_FAST_BUS
+    *_regCS = *_regCS & ~_maskCS;
+    _group->_bus.put(data[n]);
+    *_regCS = *_regCS | _maskCS;
+#else
+    digitalWrite(_pinCS, LOW);
+    _group->_bus.put(data[n]);
+    digitalWrite(_pinCS, HIGH);
+#endif
+  }
+}
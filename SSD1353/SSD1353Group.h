@@ -0,0 +1,91 @@
+/*
+  SSD1353Group.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353GROUP_H
+#define SSD1353GROUP_H
+
+#include "SSD1353.h"
+
+// Most panels in a group
+#define SSD1353_GROUP_PANELS 4
+
+// select() value for every panel of the group
+#define SSD1353_GROUP_ALL 0xFF
+
+class SSD1353Group;
+
+// One panel of an SSD1353Group, drawing on it reaches only this panel
+class SSD1353Panel : public SSD1353Base {
+  public:
+  void init();
+
+  protected:
+  void busBegin();
+  void busEnd();
+  void busWrite(const uint8_t* data, uint16_t length, bool isCommand);
+
+  private:
+  friend class SSD1353Group;
+
+  SSD1353Group* _group = nullptr;
+  uint8_t _pinCS,
+      _pinDISF;
+
+#ifdef SSD1353_FAST_BUS
+  SSD1353_PORT_REG _regCS;
+  SSD1353_PORT_T _maskCS;
+#endif
+};
+
+/**
+ * @brief Panels sharing DC, RS and D0-D7, told apart by their CS lines
+ *
+ * Drawing on the group itself is broadcast: every selected panel has its
+ * CS asserted at once and takes the same bytes. Color depth changes made
+ * through the group are passed on to the panels.
+ */
+class SSD1353Group : public SSD1353Base {
+  public:
+  void init(uint8_t pinDC, uint8_t pinRS, uint8_t pinD0, uint8_t pinD1, uint8_t pinD2, uint8_t pinD3, uint8_t pinD4, uint8_t pinD5, uint8_t pinD6, uint8_t pinD7);
+  bool addPanel(SSD1353Panel& panel, uint8_t pinCS, uint8_t pinDISF);
+  void begin();
+  void select(uint8_t panels);
+  uint8_t selected() const { return _selected; }
+  uint8_t panelCount() const { return _panelCount; }
+  void setColorDepth(uint8_t depth);
+
+  protected:
+  void busBegin();
+  void busEnd();
+  void busWrite(const uint8_t* data, uint16_t length, bool isCommand);
+
+  private:
+  friend class SSD1353Panel;
+
+  SSD1353ParallelBus _bus;
+  SSD1353Panel* _panels[SSD1353_GROUP_PANELS];
+  uint8_t _panelCount = 0;
+  uint8_t _selected   = SSD1353_GROUP_ALL;
+  uint8_t _pinRS;
+
+#ifdef SSD1353_FAST_BUS
+  // CS lines of the selected panels grouped by port, toggled with one store per port
+  SSD1353_PORT_REG _selectReg[SSD1353_GROUP_PANELS];
+  SSD1353_PORT_T _selectMask[SSD1353_GROUP_PANELS];
+  uint8_t _selectPorts = 0;
+#endif
+};
+
+#endif
@@ -0,0 +1,193 @@
+/*
+  SSD1353Image.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Image.h"
+#include <Arduino.h>
+
+// Image in program memory, the palette is read in place
+class ProgmemImageSource : public SSD1353ImageSource {
+  public:
+  ProgmemImageSource(const uint8_t* image)
+      : _image(image), _next(image) {}
+
+  int read() { return pgm_read_byte(_next++); }
+
+  bool loadPalette(uint8_t size) {
+    _next += size * 2;
+    return true;
+  }
+
+  uint16_t paletteColor(uint8_t index) {
+    const uint8_t* color = _image + SSD1353_IMAGE_HEADER + index * 2;
+    return pgm_read_byte(color) | (pgm_read_byte(color + 1) << 8);
+  }
+
+  private:
+  const uint8_t* _image;
+  const uint8_t* _next;
+};
+
+// Image read from a Stream, the palette is copied to RAM
+class StreamImageSource : public SSD1353ImageSource {
+  public:
+  StreamImageSource(Stream& stream)
+      : _stream(stream) {}
+
+  int read() {
+    unsigned long start = millis();
+    int c;
+    while ((c = _stream.read()) < 0)
+      if (millis() - start >= SSD1353_IMAGE_TIMEOUT_MS)
+        return -1;
+    return c;
+  }
+
+  bool loadPalette(uint8_t size) {
+    if (size > SSD1353_IMAGE_STREAM_PALETTE)
+      return false;
+    for (uint8_t i = 0; i < size; i++) {
+      int low  = read();
+      int high = read();
+      if (low < 0 || high < 0)
+        return false;
+      _palette[i] = low | (high << 8);
+    }
+    return true;
+  }
+
+  uint16_t paletteColor(uint8_t index) { return _palette[index]; }
+
+  private:
+  Stream& _stream;
+  uint16_t _palette[SSD1353_IMAGE_STREAM_PALETTE];
+};
+
+/**
+ * @brief Decode a run-length encoded image straight into a display window
+ *
+ * Pixels are converted in a small buffer and streamed as they are
+ * decoded, the image is never held in RAM. Only the part inside the
+ * display's clip rectangle is sent, the rest is decoded and dropped so a
+ * stream is always read to the end of the image. Palette indices past the
+ * end of the palette are drawn black.
+ *
+ * @param display Display the image is drawn on
+ * @param x Image bottom left corner X coordinate
+ * @param y Image bottom left corner Y coordinate
+ * @param source Encoded image
+ * @return Whole image was decoded, true/false
+ */
+bool ssd1353DrawImage(SSD1353Base& display, uint8_t x, uint8_t y, SSD1353ImageSource& source) {
+  int width   = source.read();
+  int height  = source.read();
+  int palette = source.read();
+  if (width <= 0 || height <= 0 || palette < 0 || !source.loadPalette(palette))
+    return false;
+
+  // Visible part in image coordinates, empty when x0 > x1
+  SSD1353Rect visible = {x, y, (uint8_t)min(x + width - 1, 0xFF), (uint8_t)min(y + height - 1, 0xFF)};
+  if (display.clipRect(visible)) {
+    visible.x0 -= x;
+    visible.y0 -= y;
+    visible.x1 -= x;
+    visible.y1 -= y;
+  } else {
+    visible = {1, 0, 0, 0};
+  }
+
+  uint16_t buff[16];
+  uint8_t buffered = 0;
+  uint16_t left    = (uint16_t)width * height;
+  uint8_t column   = 0;
+  uint8_t row      = 0;
+  bool complete    = true;
+
+  display.beginWrite();
+  if (visible.x0 <= visible.x1)
+    display.setWindow(x + visible.x0, y + visible.y0, x + visible.x1, y + visible.y1);
+  while (left) {
+    int packet = source.read();
+    if (packet < 0) {
+      complete = false;
+      break;
+    }
+
+    bool run       = packet & SSD1353_IMAGE_RUN;
+    uint8_t count  = (packet & ~SSD1353_IMAGE_RUN) + 1;
+    uint16_t pixel = 0;
+    for (uint8_t i = 0; i < count && left; i++) {
+      if (i == 0 || !run) {
+        int low  = source.read();
+        int high = palette ? 0 : source.read();
+        if (low < 0 || high < 0) {
+          complete = false;
+          left     = 0;
+          break;
+        }
+        if (palette)
+          pixel = low < palette ? source.paletteColor(low) : 0;
+        else
+          pixel = low | (high << 8);
+      }
+
+      if (column >= visible.x0 && column <= visible.x1 && row >= visible.y0 && row <= visible.y1) {
+        buff[buffered++] = pixel;
+        if (buffered == sizeof(buff) / sizeof(buff[0])) {
+          display.writePixels(buff, buffered);
+          buffered = 0;
+        }
+      }
+      if (++column == width) {
+        column = 0;
+        row++;
+      }
+      left--;
+    }
+  }
+  if (buffered)
+    display.writePixels(buff, buffered);
+  display.endWrite();
+
+  return complete;
+}
+
+/**
+ * @brief Draw a run-length encoded image stored in program memory
+ *
+ * @param x Image bottom left corner X coordinate
+ * @param y Image bottom left corner Y coordinate
+ * @param image Encoded image in PROGMEM, see SSD1353Image.h
+ * @return Whole image was decoded, true/false
+ */
+bool SSD1353Base::drawImage(uint8_t x, uint8_t y, const uint8_t* image) {
+  ProgmemImageSource source(image);
+  return ssd1353DrawImage(*this, x, y, source);
+}
+
+/**
+ * @brief Draw a run-length encoded image read from a stream
+ *
+ * The image may have at most SSD1353_IMAGE_STREAM_PALETTE palette colors.
+ * A stream that stalls for SSD1353_IMAGE_TIMEOUT_MS ends the image.
+ *
+ * @param x Image bottom left corner X coordinate
+ * @param y Image bottom left corner Y coordinate
+ * @param stream Stream the encoded image is read from, see SSD1353Image.h
+ * @return Whole image was decoded, true/false
+ */
+bool SSD1353Base::drawImage(uint8_t x, uint8_t y, Stream& stream) {
+  StreamImageSource source(stream);
+  return ssd1353DrawImage(*this, x, y, source);
+}
@@ -0,0 +1,56 @@
+/*
+  SSD1353Image.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353IMAGE_H
+#define SSD1353IMAGE_H
+
+#include "SSD1353.h"
+
+// Run-length encoded image format, as written by host/tools/png2rle.py
+//
+//   byte 0      width
+//   byte 1      height
+//   byte 2      palette size, 0 for direct RGB565 pixels
+//   then        palette size RGB565 colors, low byte first
+//   then        packets until width * height pixels, bottom row first
+//
+// A packet byte with the high bit set is a run of (low 7 bits + 1) copies
+// of the single pixel value that follows. Otherwise it is followed by
+// (byte + 1) literal pixel values. A pixel value is a palette index byte,
+// or an RGB565 color low byte first when there is no palette.
+#define SSD1353_IMAGE_HEADER 3
+#define SSD1353_IMAGE_RUN    0x80
+
+// Largest palette a Stream image may have, the palette is kept in RAM
+#ifndef SSD1353_IMAGE_STREAM_PALETTE
+#define SSD1353_IMAGE_STREAM_PALETTE 16
+#endif
+
+// Time to wait for each byte of a Stream image
+#ifndef SSD1353_IMAGE_TIMEOUT_MS
+#define SSD1353_IMAGE_TIMEOUT_MS 1000
+#endif
+
+// Byte source the image decoder reads from
+class SSD1353ImageSource {
+  public:
+  virtual int read() = 0;
+  virtual bool loadPalette(uint8_t size) = 0;
+  virtual uint16_t paletteColor(uint8_t index) = 0;
+};
+
+bool ssd1353DrawImage(SSD1353Base& display, uint8_t x, uint8_t y, SSD1353ImageSource& source);
+
+#endif
@@ -0,0 +1,46 @@
+/*
+  SSD1353Queue.h - Storage and state of the asynchronous transfer queue
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353QUEUE_H
+#define SSD1353QUEUE_H
+
+#include "SSD1353.h"
+
+// Transfer queue for SSD1353Base::beginAsync(), see SSD1353Async.cpp. The
+// display only keeps a pointer to it, sketches that never queue pay for
+// nothing else. The drawing calls add at the tail, poll() may take from
+// the head in an interrupt.
+class SSD1353Queue {
+  public:
+  SSD1353Queue(uint8_t* buffer, uint16_t size)
+      : _buffer(buffer), _size(size) {}
+
+  private:
+  friend class SSD1353Base;
+
+  uint8_t* _buffer;
+  uint16_t _size;
+  uint16_t _tail           = 0;
+  volatile uint16_t _head  = 0;
+  volatile uint16_t _count = 0;
+  volatile uint16_t _last  = 0xFFFF; // Segment header that can still grow, 0xFFFF when none
+  uint8_t _readLeft        = 0;      // Bytes left in the segment being sent
+  bool _readCommand        = false;
+  volatile bool _draining  = false; // Queue is being sent, the bus is taken
+  volatile bool _sent      = false; // Bytes were sent since the last onComplete
+  void (*_onComplete)()    = nullptr;
+};
+
+#endif
@@ -0,0 +1,106 @@
+/*
+  SSD1353SPI.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353SPI.h"
+#include <Arduino.h>
+
+/**
+ * @brief SSD1353 initialization function for the SPI interface
+ *
+ * @param pinCS Display pin CS
+ * @param pinDC Display pin DC
+ * @param pinRS Display pin RS
+ * @param pinDISF Display pin DISF
+ * @param clock SPI clock in Hz
+ */
+void SSD1353SPI::init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF, uint32_t clock) {
+  _pinCS     = pinCS;
+  _pinDC     = pinDC;
+  _pinRS     = pinRS;
+  _pinDISF   = pinDISF;
+  _byteNanos = byteNanos(clock);
+  _settings  = SPISettings(clock, MSBFIRST, SPI_MODE0);
+
+  pinMode(_pinCS, OUTPUT);
+  pinMode(_pinDC, OUTPUT);
+  pinMode(_pinRS, OUTPUT);
+  pinMode(_pinDISF, OUTPUT);
+  digitalWrite(_pinCS, HIGH);
+  _spi.begin();
+
+#ifdef SSD1353_FAST_BUS
+  _regCS  = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(_pinCS));
+  _maskCS = digitalPinToBitMask(_pinCS);
+  _regDC  = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(_pinDC));
+  _maskDC = digitalPinToBitMask(_pinDC);
+#endif
+
+  // Display reset sequence
+  digitalWrite(_pinDISF, LOW);
+  digitalWrite(_pinRS, LOW);
+  delay(10);
+  digitalWrite(_pinRS, HIGH);
+  delay(10);
+
+  initSequence();
+  digitalWrite(_pinDISF, HIGH);
+}
+
+/**
+ * @brief Take the SPI bus and select the display
+ *
+ */
+void SSD1353SPI::busBegin() {
+  _spi.beginTransaction(_settings);
+#ifdef SSD1353_FAST_BUS
+  *_regCS = *_regCS & ~_maskCS;
+#else
+  digitalWrite(_pinCS, LOW);
+#endif
+}
+
+/**
+ * @brief Deselect the display and release the SPI bus
+ *
+ */
+void SSD1353SPI::busEnd() {
+#ifdef SSD1353_FAST_BUS
+  *_regCS = *_regCS | _maskCS;
+#else
+  digitalWrite(_pinCS, HIGH);
+#endif
+  _spi.endTransaction();
+}
+
+/**
+ * @brief Write data to driver
+ *
+ * @param data Pointer to the bytes to be written
+ * @param length Number of bytes
+ * @param isCommand Bytes are commands, true/false
+ */
+void SSD1353SPI::busWrite(const uint8_t* data, uint16_t length, bool isCommand) {
+#ifdef SSD1353_FAST_BUS
+  if (isCommand)
+    *_regDC = *_regDC & ~_maskDC;
+  else
+    *_regDC = *_regDC | _maskDC;
+#else
+  digitalWrite(_pinDC, !isCommand);
+#endif
+
+  for (uint16_t n = 0; n < length; n++)
+    _spi.transfer(data[n]);
+}
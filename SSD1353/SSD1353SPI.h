@@ -0,0 +1,68 @@
+/*
+  SSD1353SPI.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353SPI_H
+#define SSD1353SPI_H
+
+#include "SSD1353.h"
+#include <SPI.h>
+
+// Serial clock limit of the controller, SPISettings rounds it down to what the MCU can do
+#ifndef SSD1353_SPI_CLOCK
+#define SSD1353_SPI_CLOCK 10000000
+#endif
+
+/**
+ * @brief SSD1353 driver on the 4-wire SPI interface
+ *
+ * D0 is the serial clock and D1 the serial data in, wired to the hardware
+ * SPI pins. CS stays low for a whole transaction.
+ */
+class SSD1353SPI : public SSD1353Base {
+  public:
+  SSD1353SPI(SPIClass& spi = SPI)
+      : _spi(spi) {}
+
+  void init(uint8_t pinCS, uint8_t pinDC, uint8_t pinRS, uint8_t pinDISF, uint32_t clock = SSD1353_SPI_CLOCK);
+  uint16_t busByteNanos() const { return _byteNanos; }
+
+  protected:
+  void busBegin();
+  void busEnd();
+  void busWrite(const uint8_t* data, uint16_t length, bool isCommand);
+
+  private:
+  // Eight clocks in nanoseconds, 32-bit math in kHz, saturated below 123 kHz
+  static constexpr uint16_t byteNanos(uint32_t clock) {
+    return clock / 1000 < 123 ? 0xFFFF : 8000000UL / (clock / 1000);
+  }
+
+  SPIClass& _spi;
+  SPISettings _settings;
+  uint16_t _byteNanos = byteNanos(SSD1353_SPI_CLOCK);
+  uint8_t _pinCS,
+      _pinDC,
+      _pinRS,
+      _pinDISF;
+
+#ifdef SSD1353_FAST_BUS
+  SSD1353_PORT_REG _regCS;
+  SSD1353_PORT_REG _regDC;
+  SSD1353_PORT_T _maskCS,
+      _maskDC;
+#endif
+};
+
+#endif
@@ -0,0 +1,167 @@
+/*
+  SSD1353Shadow.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Shadow.h"
+#include <Arduino.h>
+
+/**
+ * @brief Check if two rectangles overlap or share an edge
+ *
+ */
+static bool touches(const SSD1353Rect& a, const SSD1353Rect& b) {
+  return a.x0 <= b.x1 + 1 && b.x0 <= a.x1 + 1 && a.y0 <= b.y1 + 1 && b.y0 <= a.y1 + 1;
+}
+
+static SSD1353Rect unite(const SSD1353Rect& a, const SSD1353Rect& b) {
+  SSD1353Rect r = {min(a.x0, b.x0), min(a.y0, b.y0), max(a.x1, b.x1), max(a.y1, b.y1)};
+  return r;
+}
+
+static uint16_t area(const SSD1353Rect& r) {
+  return (uint16_t)(r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+}
+
+/**
+ * @brief Construct a shadow drawing surface
+ *
+ * @param display Display the changes are sent to
+ * @param canvas Canvas holding the shadow copy of the display contents
+ */
+SSD1353Shadow::SSD1353Shadow(SSD1353Base& display, SSD1353Canvas& canvas)
+    : _display(display), _canvas(canvas) {}
+
+/**
+ * @brief Draw a rectangle on the shadow canvas
+ *
+ * @param startX Bottom left corner X coordinate
+ * @param startY Bottom left corner Y coordinate
+ * @param endX Top right corner X coordinate
+ * @param endY Top right corner Y coordinate
+ * @param lineRed Border line red color value
+ * @param lineGreen Border line green color value
+ * @param lineBlue Border line blue color value
+ * @param fillRed Rectangle fill red color value
+ * @param fillGreen Rectangle fill green color value
+ * @param fillBlue Rectangle fill blue color value
+ * @param useFill Fill the rectangle, true/false
+ */
+void SSD1353Shadow::drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  _canvas.drawRectangle(startX, startY, endX, endY, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+
+  if (useFill) {
+    markDirty(startX, startY, endX, endY);
+  } else {
+    // An outline only touches its four edges
+    markDirty(startX, startY, endX, startY);
+    markDirty(startX, endY, endX, endY);
+    markDirty(startX, startY, startX, endY);
+    markDirty(endX, startY, endX, endY);
+  }
+}
+
+/**
+ * @brief Draw a line on the shadow canvas
+ *
+ * @param startX Starting point X coordinate
+ * @param startY Starting point Y coordinate
+ * @param endX Ending point X coordinate
+ * @param endY Ending point Y coordinate
+ * @param lineRed Line red color value
+ * @param lineGreen Line green color  value
+ * @param lineBlue Line blue color value
+ */
+void SSD1353Shadow::drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue) {
+  _canvas.drawLine(startX, startY, endX, endY, lineRed, lineGreen, lineBlue);
+  markDirty(startX, startY, endX, endY);
+}
+
+/**
+ * @brief Record an area as changed
+ *
+ * Overlapping and adjacent areas are merged. When all slots are taken the
+ * area is merged into the slot whose bounding box grows the least.
+ *
+ * @param startX First corner X coordinate
+ * @param startY First corner Y coordinate
+ * @param endX Opposite corner X coordinate
+ * @param endY Opposite corner Y coordinate
+ */
+void SSD1353Shadow::markDirty(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY) {
+  SSD1353Rect rect = {min(startX, endX), min(startY, endY), max(startX, endX), max(startY, endY)};
+
+  for (uint8_t i = 0; i < _dirtyCount; i++) {
+    if (touches(_dirty[i], rect)) {
+      _dirty[i] = unite(_dirty[i], rect);
+      mergeDirty(i);
+      return;
+    }
+  }
+
+  if (_dirtyCount < SSD1353_DIRTY_RECTS) {
+    _dirty[_dirtyCount++] = rect;
+    return;
+  }
+
+  uint8_t best    = 0;
+  uint16_t growth = 0xFFFF;
+  for (uint8_t i = 0; i < _dirtyCount; i++) {
+    uint16_t g = area(unite(_dirty[i], rect)) - area(_dirty[i]);
+    if (g < growth) {
+      growth = g;
+      best   = i;
+    }
+  }
+  _dirty[best] = unite(_dirty[best], rect);
+  mergeDirty(best);
+}
+
+/**
+ * @brief Merge slot i with every slot it has grown to touch
+ *
+ * @param i Index of the slot that grew
+ */
+void SSD1353Shadow::mergeDirty(uint8_t i) {
+  for (uint8_t j = 0; j < _dirtyCount; j++) {
+    if (j == i || !touches(_dirty[i], _dirty[j]))
+      continue;
+
+    _dirty[i] = unite(_dirty[i], _dirty[j]);
+    _dirty[j] = _dirty[--_dirtyCount];
+    if (i == _dirtyCount)
+      i = j;
+    j = (uint8_t)-1; // The merged slot may now touch earlier slots
+  }
+}
+
+/**
+ * @brief Send the changed areas to the display
+ *
+ */
+void SSD1353Shadow::flush() {
+  _display.beginWrite();
+  for (uint8_t i = 0; i < _dirtyCount; i++)
+    _canvas.flush(_display, _dirty[i]);
+  _display.endWrite();
+  _dirtyCount = 0;
+}
+
+/**
+ * @brief Send the whole shadow canvas to the display
+ *
+ */
+void SSD1353Shadow::flushAll() {
+  _canvas.flush(_display);
+  _dirtyCount = 0;
+}
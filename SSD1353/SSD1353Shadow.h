@@ -0,0 +1,51 @@
+/*
+  SSD1353Shadow.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353SHADOW_H
+#define SSD1353SHADOW_H
+
+#include "SSD1353.h"
+#include "SSD1353Canvas.h"
+
+#ifndef SSD1353_DIRTY_RECTS
+#define SSD1353_DIRTY_RECTS 8
+#endif
+
+// Draws into a shadow canvas and sends only the changed areas to the display
+class SSD1353Shadow : public SSD1353Gfx {
+  public:
+  SSD1353Shadow(SSD1353Base& display, SSD1353Canvas& canvas);
+
+  void drawRectangle(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill);
+  void drawLine(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue);
+  using SSD1353Gfx::drawRectangle;
+  using SSD1353Gfx::drawLine;
+  void markDirty(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY);
+  void flush();
+  void flushAll();
+
+  uint8_t dirtyCount() const { return _dirtyCount; }
+  const SSD1353Rect& dirtyRect(uint8_t i) const { return _dirty[i]; }
+
+  private:
+  SSD1353Base& _display;
+  SSD1353Canvas& _canvas;
+  SSD1353Rect _dirty[SSD1353_DIRTY_RECTS];
+  uint8_t _dirtyCount = 0;
+
+  void mergeDirty(uint8_t i);
+};
+
+#endif
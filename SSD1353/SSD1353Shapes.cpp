@@ -0,0 +1,375 @@
+/*
+  SSD1353Shapes.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353.h"
+#include <Arduino.h>
+
+// Rows with the same span, vertically adjacent, collected into one
+// rectangle. Only finished bands are drawn: a filled rectangle, or a
+// line when the band is one pixel wide or high.
+class SpanBand {
+  public:
+  SpanBand(SSD1353Gfx& gfx, uint8_t red, uint8_t green, uint8_t blue)
+      : _gfx(gfx), _red(red), _green(green), _blue(blue), _empty(true) {}
+
+  ~SpanBand() { flush(); }
+
+  void add(int16_t left, int16_t right, int16_t top, int16_t bottom) {
+    if (!_empty && left == _left && right == _right) {
+      if (top == _bottom + 1) {
+        _bottom = bottom;
+        return;
+      }
+      if (bottom == _top - 1) {
+        _top = top;
+        return;
+      }
+    }
+    flush();
+    _left   = left;
+    _right  = right;
+    _top    = top;
+    _bottom = bottom;
+    _empty  = false;
+  }
+
+  void add(int16_t left, int16_t right, int16_t y) { add(left, right, y, y); }
+
+  // Take over the other band when the two continue each other
+  void join(SpanBand& other) {
+    if (_empty || other._empty || other._left != _left || other._right != _right || other._top != _bottom + 1)
+      return;
+    _bottom      = other._bottom;
+    other._empty = true;
+  }
+
+  void flush() {
+    if (_empty)
+      return;
+    _empty = true;
+
+    int16_t left   = _left < 0 ? 0 : _left;
+    int16_t right  = _right > SSD1353_WIDTH - 1 ? SSD1353_WIDTH - 1 : _right;
+    int16_t top    = _top < 0 ? 0 : _top;
+    int16_t bottom = _bottom > SSD1353_HEIGHT - 1 ? SSD1353_HEIGHT - 1 : _bottom;
+    if (left > right || top > bottom)
+      return;
+
+    if (left == right || top == bottom)
+      _gfx.drawLine(left, top, right, bottom, _red, _green, _blue);
+    else
+      _gfx.drawRectangle(left, top, right, bottom, _red, _green, _blue, _red, _green, _blue, true);
+  }
+
+  private:
+  SSD1353Gfx& _gfx;
+  uint8_t _red,
+      _green,
+      _blue;
+  bool _empty;
+  int16_t _left,
+      _right,
+      _top,
+      _bottom;
+};
+
+// Division rounded to the nearest integer, halves away from zero
+static int16_t roundDiv(int32_t numerator, int32_t denominator) {
+  return numerator < 0 ? -((-numerator + denominator / 2) / denominator) : (numerator + denominator / 2) / denominator;
+}
+
+// Quarter ellipse profile: widest x offset still inside on row offset y,
+// x^2 / (rx + 1/2)^2 + y^2 / (ry + 1/2)^2 <= 1 in integers
+class EllipseProfile {
+  public:
+  EllipseProfile(uint8_t radiusX, uint8_t radiusY)
+      : _a(2 * radiusX + 1),
+        _b(2 * radiusY + 1),
+        _stepQuotient(2 * _b / _a),
+        _stepRemainder(2 * _b % _a),
+        _quotient(_stepQuotient),
+        _remainder(_stepRemainder),
+        _x(0),
+        _radiusX(radiusX) {}
+
+  // Rows must be asked for from the outermost inwards
+  int16_t widthAt(uint8_t y) {
+    while (_x < _radiusX && inside(y)) {
+      _x++;
+      _quotient += _stepQuotient;
+      _remainder += _stepRemainder;
+      if (_remainder >= _a) {
+        _remainder -= _a;
+        _quotient++;
+      }
+    }
+    return _x;
+  }
+
+  private:
+  uint16_t _a,
+      _b,
+      _stepQuotient,
+      _stepRemainder,
+      _quotient, // 2(_x + 1)b = quotient * a + remainder
+      _remainder;
+  int16_t _x;
+  uint8_t _radiusX;
+
+  // Whether column _x + 1 is inside row y: (2xb)^2 <= a^2 (b^2 - 4y^2), with
+  // a = 2rx + 1 and b = 2ry + 1. Split as 2xb = qa + r it becomes
+  // r(2qa + r) <= a^2 (b^2 - 4y^2 - q^2). With r < a it fails when the last
+  // factor is negative and holds when it is over 2q; in between every term
+  // fits in 32 bits, where the products of the first form need 37.
+  bool inside(uint8_t y) const {
+    int32_t left = (int32_t)_b * _b - 4L * y * y - (int32_t)_quotient * _quotient;
+    if (left < 0)
+      return false;
+    if (left > 2 * (int32_t)_quotient)
+      return true;
+    return (uint32_t)_remainder * (2UL * _quotient * _a + _remainder) <= (uint32_t)_a * _a * left;
+  }
+};
+
+/**
+ * @brief Draw an ellipse stretched apart into a rounded rectangle
+ *
+ * The quarter profile is worked out once and mirrored into all four
+ * corners. Filled, rows of equal width join into hardware rectangles;
+ * outlined, each row becomes a horizontal run where the edge is flat and
+ * runs of single pixels join into vertical lines where it is steep.
+ *
+ * @param left X of the left corner centers
+ * @param right X of the right corner centers
+ * @param top Y of the lower corner centers
+ * @param bottom Y of the upper corner centers
+ * @param radiusX Horizontal corner radius
+ * @param radiusY Vertical corner radius
+ */
+void SSD1353Gfx::drawRound(int16_t left, int16_t right, int16_t top, int16_t bottom, uint8_t radiusX, uint8_t radiusY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  bool outline = !useFill || lineRed != fillRed || lineGreen != fillGreen || lineBlue != fillBlue;
+
+  if (useFill) {
+    EllipseProfile profile(radiusX, radiusY);
+    SpanBand upper(*this, fillRed, fillGreen, fillBlue);
+    SpanBand lower(*this, fillRed, fillGreen, fillBlue);
+    for (int16_t dy = radiusY; dy >= 0; dy--) {
+      int16_t x = profile.widthAt(dy);
+      upper.add(left - x, right + x, top - dy);
+      if (dy || bottom != top)
+        lower.add(left - x, right + x, bottom + dy);
+    }
+    // Straight sides in between
+    if (bottom > top + 1)
+      upper.add(left - radiusX, right + radiusX, top + 1, bottom - 1);
+    upper.join(lower);
+  }
+
+  if (!outline)
+    return;
+
+  EllipseProfile profile(radiusX, radiusY);
+  SpanBand upperLeft(*this, lineRed, lineGreen, lineBlue);
+  SpanBand upperRight(*this, lineRed, lineGreen, lineBlue);
+  SpanBand lowerLeft(*this, lineRed, lineGreen, lineBlue);
+  SpanBand lowerRight(*this, lineRed, lineGreen, lineBlue);
+  int16_t previous = profile.widthAt(radiusY);
+
+  // Outermost rows are one run across, including any straight edge
+  upperLeft.add(left - previous, right + previous, top - radiusY);
+  if (bottom != top || radiusY)
+    lowerLeft.add(left - previous, right + previous, bottom + radiusY);
+
+  for (int16_t dy = radiusY - 1; dy >= 0; dy--) {
+    int16_t x     = profile.widthAt(dy);
+    int16_t inner = x > previous ? previous + 1 : x;
+    upperLeft.add(left - x, left - inner, top - dy);
+    upperRight.add(right + inner, right + x, top - dy);
+    if (dy || bottom != top) {
+      lowerLeft.add(left - x, left - inner, bottom + dy);
+      lowerRight.add(right + inner, right + x, bottom + dy);
+    }
+    previous = x;
+  }
+
+  if (bottom > top + 1) {
+    upperLeft.add(left - previous, left - previous, top + 1, bottom - 1);
+    upperRight.add(right + previous, right + previous, top + 1, bottom - 1);
+  }
+  upperLeft.join(lowerLeft);
+  upperRight.join(lowerRight);
+}
+
+/**
+ * @brief Draw a circle
+ *
+ * @param x Center X coordinate
+ * @param y Center Y coordinate
+ * @param radius Radius in pixels
+ * @param lineRed Outline red color value
+ * @param lineGreen Outline green color value
+ * @param lineBlue Outline blue color value
+ * @param fillRed Fill red color value
+ * @param fillGreen Fill green color value
+ * @param fillBlue Fill blue color value
+ * @param useFill Fill the circle, true/false
+ */
+void SSD1353Gfx::drawCircle(uint8_t x, uint8_t y, uint8_t radius, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  drawRound(x, x, y, y, radius, radius, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+}
+
+/**
+ * @brief Draw an axis-aligned ellipse
+ *
+ * @param x Center X coordinate
+ * @param y Center Y coordinate
+ * @param radiusX Horizontal radius in pixels
+ * @param radiusY Vertical radius in pixels
+ * @param lineRed Outline red color value
+ * @param lineGreen Outline green color value
+ * @param lineBlue Outline blue color value
+ * @param fillRed Fill red color value
+ * @param fillGreen Fill green color value
+ * @param fillBlue Fill blue color value
+ * @param useFill Fill the ellipse, true/false
+ */
+void SSD1353Gfx::drawEllipse(uint8_t x, uint8_t y, uint8_t radiusX, uint8_t radiusY, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  drawRound(x, x, y, y, radiusX, radiusY, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+}
+
+/**
+ * @brief Draw a rectangle with rounded corners
+ *
+ * @param startX Bottom left corner X coordinate
+ * @param startY Bottom left corner Y coordinate
+ * @param endX Top right corner X coordinate
+ * @param endY Top right corner Y coordinate
+ * @param radius Corner radius, limited to half the shorter side
+ * @param lineRed Outline red color value
+ * @param lineGreen Outline green color value
+ * @param lineBlue Outline blue color value
+ * @param fillRed Fill red color value
+ * @param fillGreen Fill green color value
+ * @param fillBlue Fill blue color value
+ * @param useFill Fill the rectangle, true/false
+ */
+void SSD1353Gfx::drawRoundRect(uint8_t startX, uint8_t startY, uint8_t endX, uint8_t endY, uint8_t radius, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  uint8_t left   = startX < endX ? startX : endX;
+  uint8_t right  = startX < endX ? endX : startX;
+  uint8_t top    = startY < endY ? startY : endY;
+  uint8_t bottom = startY < endY ? endY : startY;
+
+  if (radius > (right - left) / 2)
+    radius = (right - left) / 2;
+  if (radius > (bottom - top) / 2)
+    radius = (bottom - top) / 2;
+  drawRound(left + radius, right - radius, top + radius, bottom - radius, radius, radius, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+}
+
+/**
+ * @brief Draw a triangle
+ *
+ * @param x0 First corner X coordinate
+ * @param y0 First corner Y coordinate
+ * @param x1 Second corner X coordinate
+ * @param y1 Second corner Y coordinate
+ * @param x2 Third corner X coordinate
+ * @param y2 Third corner Y coordinate
+ * @param lineRed Outline red color value
+ * @param lineGreen Outline green color value
+ * @param lineBlue Outline blue color value
+ * @param fillRed Fill red color value
+ * @param fillGreen Fill green color value
+ * @param fillBlue Fill blue color value
+ * @param useFill Fill the triangle, true/false
+ */
+void SSD1353Gfx::drawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  SSD1353Point points[] = {{x0, y0}, {x1, y1}, {x2, y2}};
+  drawPolygon(points, 3, lineRed, lineGreen, lineBlue, fillRed, fillGreen, fillBlue, useFill);
+}
+
+/**
+ * @brief Draw a polygon
+ *
+ * The outline is drawn with hardware lines. Filling is done one row span
+ * at a time and is only right for convex polygons.
+ *
+ * @param points Corners in drawing order
+ * @param count Number of corners
+ * @param lineRed Outline red color value
+ * @param lineGreen Outline green color value
+ * @param lineBlue Outline blue color value
+ * @param fillRed Fill red color value
+ * @param fillGreen Fill green color value
+ * @param fillBlue Fill blue color value
+ * @param useFill Fill the polygon, true/false
+ */
+void SSD1353Gfx::drawPolygon(const SSD1353Point* points, uint8_t count, uint8_t lineRed, uint8_t lineGreen, uint8_t lineBlue, uint8_t fillRed, uint8_t fillGreen, uint8_t fillBlue, bool useFill) {
+  if (!count)
+    return;
+
+  if (useFill) {
+    uint8_t top    = points[0].y;
+    uint8_t bottom = points[0].y;
+    for (uint8_t i = 1; i < count; i++) {
+      top    = min(top, points[i].y);
+      bottom = max(bottom, points[i].y);
+    }
+
+    SpanBand band(*this, fillRed, fillGreen, fillBlue);
+    for (int16_t y = top; y <= bottom; y++) {
+      int16_t left  = SSD1353_WIDTH;
+      int16_t right = -1;
+
+      // Every edge covers the part of itself lying within half a pixel of the row
+      for (uint8_t i = 0; i < count; i++) {
+        SSD1353Point a = points[i];
+        SSD1353Point b = points[i + 1 == count ? 0 : i + 1];
+        if (a.y > b.y) {
+          SSD1353Point swap = a;
+          a                 = b;
+          b                 = swap;
+        }
+        if (y < a.y || y > b.y)
+          continue;
+
+        int16_t from = a.x;
+        int16_t to   = b.x;
+        if (a.y != b.y) {
+          // Edge x at y - 1/2 and y + 1/2, clamped to the ends of the edge
+          int16_t span = 2 * (b.y - a.y);
+          int16_t low  = max(2 * y - 1, 2 * a.y) - 2 * a.y;
+          int16_t high = min(2 * y + 1, 2 * b.y) - 2 * a.y;
+          int16_t dx   = (int16_t)b.x - a.x;
+          from         = a.x + roundDiv((int32_t)dx * low, span);
+          to           = a.x + roundDiv((int32_t)dx * high, span);
+        }
+        left  = min(left, min(from, to));
+        right = max(right, max(from, to));
+      }
+      band.add(left, right, y);
+    }
+  }
+
+  if (useFill && lineRed == fillRed && lineGreen == fillGreen && lineBlue == fillBlue)
+    return;
+  // Two corners make a single line, not a line drawn both ways
+  uint8_t edges = count == 2 ? 1 : count;
+  for (uint8_t i = 0; i < edges; i++) {
+    const SSD1353Point& a = points[i];
+    const SSD1353Point& b = points[i + 1 == count ? 0 : i + 1];
+    drawLine(a.x, a.y, b.x, b.y, lineRed, lineGreen, lineBlue);
+  }
+}
@@ -0,0 +1,214 @@
+/*
+  SSD1353Strokes.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353STROKES_H
+#define SSD1353STROKES_H
+
+#include "SSD1353Font.h"
+
+// Compile-time stroke compiler for the glyphs in SSD1353Font.h.
+//
+// Each glyph is covered with the fewest horizontal and vertical runs.
+// Every lit pixel is an edge between the horizontal run and the vertical
+// run it belongs to, so the smallest set of runs covering all pixels is a
+// minimum vertex cover of that bipartite graph. By König's theorem it
+// follows from a maximum matching. Everything below runs in the compiler
+// (C++11 constexpr) and only the packed stroke table reaches flash.
+//
+// A glyph is handled as a 35-bit mask, pixel p = column * 7 + row. A run is
+// named by the pixel it starts from. A stroke byte is the start pixel of a
+// maximal run, with bit 6 set for vertical runs; the run length is read
+// back from the glyph bitmap when drawing.
+
+#define SSD1353_STROKE_VERTICAL 0x40
+#define SSD1353_GLYPHS          (SSD1353_FONT_LAST - SSD1353_FONT_FIRST + 2)
+
+namespace SSD1353Strokes {
+  typedef uint64_t Mask;
+
+  constexpr Mask bit(int p) { return (Mask)1 << p; }
+
+  constexpr Mask glyph(uint16_t g, uint8_t i = 0) {
+    return i == SSD1353_FONT_WIDTH ? 0 : (Mask)ssd1353Font[g * SSD1353_FONT_WIDTH + i] << (i * 7) | glyph(g, i + 1);
+  }
+
+  constexpr bool px(Mask g, int i, int j) {
+    return i >= 0 && i < SSD1353_FONT_WIDTH && j >= 0 && j < SSD1353_FONT_HEIGHT && ((g >> (i * 7 + j)) & 1);
+  }
+
+  constexpr int hStart(Mask g, int i, int j) { return px(g, i - 1, j) ? hStart(g, i - 1, j) : i; }
+  constexpr int vStart(Mask g, int i, int j) { return px(g, i, j - 1) ? vStart(g, i, j - 1) : j; }
+  constexpr int hRun(Mask g, int p) { return hStart(g, p / 7, p % 7) * 7 + p % 7; }
+  constexpr int vRun(Mask g, int p) { return p / 7 * 7 + vStart(g, p / 7, p % 7); }
+
+  // Matched pixel in the vertical run through (i, j) and above, or -1
+  constexpr int matchInV(Mask g, Mask m, int i, int j) {
+    return !px(g, i, j) ? -1 : ((m >> (i * 7 + j)) & 1) ? i * 7 + j : matchInV(g, m, i, j + 1);
+  }
+
+  struct Augment {
+    bool ok;
+    Mask match;
+    Mask visited; // Vertical runs already tried
+  };
+
+  constexpr Augment tryRun(Mask g, Mask m, Mask visited, int i, int j);
+
+  constexpr Augment tryAugmented(Mask g, int i, int j, int q, Augment r) {
+    return r.ok ? Augment{true, (r.match & ~bit(q)) | bit(i * 7 + j), r.visited} : tryRun(g, r.match, r.visited, i + 1, j);
+  }
+
+  constexpr Augment tryMatched(Mask g, Mask m, Mask visited, int i, int j, int q) {
+    return q < 0 ? Augment{true, m | bit(i * 7 + j), visited}
+                 : tryAugmented(g, i, j, q, tryRun(g, m, visited, hStart(g, q / 7, q % 7), q % 7));
+  }
+
+  // Kuhn's augmenting path search from the horizontal run continuing at (i, j)
+  constexpr Augment tryRun(Mask g, Mask m, Mask visited, int i, int j) {
+    return !px(g, i, j)                              ? Augment{false, m, visited}
+           : ((visited >> vRun(g, i * 7 + j)) & 1) ? tryRun(g, m, visited, i + 1, j)
+                                                     : tryMatched(g, m, visited | bit(vRun(g, i * 7 + j)), i, j, matchInV(g, m, i, vStart(g, i, j)));
+  }
+
+  constexpr bool isHStart(Mask g, int p) { return px(g, p / 7, p % 7) && hRun(g, p) == p; }
+
+  constexpr Mask matching(Mask g, Mask m = 0, int p = 0) {
+    return p == 35 ? m : matching(g, isHStart(g, p) ? tryRun(g, m, 0, p / 7, p % 7).match : m, p + 1);
+  }
+
+  // Runs reachable from unmatched horizontal runs along alternating paths
+  struct Reach {
+    Mask h,
+        v;
+  };
+
+  constexpr Reach reachStep(Mask g, Mask m, Reach z, int p = 0) {
+    return p == 35 ? z
+           : !px(g, p / 7, p % 7)
+               ? reachStep(g, m, z, p + 1)
+           : (!((m >> p) & 1) && ((z.h >> hRun(g, p)) & 1))
+               ? reachStep(g, m, Reach{z.h, z.v | bit(vRun(g, p))}, p + 1)
+           : (((m >> p) & 1) && ((z.v >> vRun(g, p)) & 1))
+               ? reachStep(g, m, Reach{z.h | bit(hRun(g, p)), z.v}, p + 1)
+               : reachStep(g, m, z, p + 1);
+  }
+
+  constexpr Reach reachFix(Mask g, Mask m, Reach z, Reach next) {
+    return next.h == z.h && next.v == z.v ? z : reachFix(g, m, next, reachStep(g, m, next));
+  }
+
+  // A horizontal run is free when none of its pixels is matched
+  constexpr bool hMatched(Mask g, Mask m, int i, int j) {
+    return px(g, i, j) && (((m >> (i * 7 + j)) & 1) || hMatched(g, m, i + 1, j));
+  }
+
+  constexpr Mask freeRuns(Mask g, Mask m, int p = 0) {
+    return p == 35 ? 0 : (isHStart(g, p) && !hMatched(g, m, p / 7, p % 7) ? bit(p) : 0) | freeRuns(g, m, p + 1);
+  }
+
+  constexpr Mask hRuns(Mask g, int p = 0) {
+    return p == 35 ? 0 : (isHStart(g, p) ? bit(p) : 0) | hRuns(g, p + 1);
+  }
+
+  // Minimum vertex cover: unreached horizontal runs and reached vertical runs
+  struct Cover {
+    Mask h,
+        v;
+  };
+
+  constexpr Cover coverOf(Mask g, Reach z) { return Cover{hRuns(g) & ~z.h, z.v}; }
+
+  constexpr Cover coverFor(Mask g, Mask m) {
+    return coverOf(g, reachFix(g, m, Reach{0, 0}, Reach{freeRuns(g, m), 0}));
+  }
+
+  constexpr Cover cover(uint16_t g) { return coverFor(glyph(g), matching(glyph(g))); }
+
+  constexpr uint8_t popcount(Mask m) { return m ? (m & 1) + popcount(m >> 1) : 0; }
+
+  // Position of the k-th set bit
+  constexpr uint8_t nthBit(Mask m, uint8_t k, uint8_t p = 0) {
+    return ((m >> p) & 1) ? (k == 0 ? p : nthBit(m, k - 1, p + 1)) : nthBit(m, k, p + 1);
+  }
+
+  template <uint16_t... Is>
+  struct Seq {};
+
+  template <uint16_t N, uint16_t... Is>
+  struct MakeSeq : MakeSeq<N - 1, N - 1, Is...> {};
+
+  template <uint16_t... Is>
+  struct MakeSeq<0, Is...> {
+    typedef Seq<Is...> type;
+  };
+
+  template <uint16_t N>
+  struct Covers {
+    Cover glyph[N];
+  };
+
+  template <uint16_t... Is>
+  constexpr Covers<sizeof...(Is)> buildCovers(Seq<Is...>) {
+    return Covers<sizeof...(Is)>{{cover(Is)...}};
+  }
+
+  constexpr Covers<SSD1353_GLYPHS> covers = buildCovers(MakeSeq<SSD1353_GLYPHS>::type());
+
+  constexpr uint8_t count(uint16_t g) { return popcount(covers.glyph[g].h) + popcount(covers.glyph[g].v); }
+
+  template <uint16_t N>
+  struct Offsets {
+    uint16_t data[N];
+  };
+
+  constexpr uint16_t sumCounts(uint16_t g) { return g == 0 ? 0 : sumCounts(g - 1) + count(g - 1); }
+
+  template <uint16_t... Is>
+  constexpr Offsets<sizeof...(Is)> buildOffsets(Seq<Is...>) {
+    return Offsets<sizeof...(Is)>{{sumCounts(Is)...}};
+  }
+
+  // First stroke of glyph g in the packed table, the last entry is the table size
+  constexpr Offsets<SSD1353_GLYPHS + 1> offsets = buildOffsets(MakeSeq<SSD1353_GLYPHS + 1>::type());
+
+  constexpr uint8_t strokeOf(uint16_t g, uint8_t k, uint8_t hCount) {
+    return k < hCount ? nthBit(covers.glyph[g].h, k) : nthBit(covers.glyph[g].v, k - hCount) | SSD1353_STROKE_VERTICAL;
+  }
+
+  constexpr uint16_t glyphAt(uint16_t n, uint16_t g = 0) { return offsets.data[g + 1] > n ? g : glyphAt(n, g + 1); }
+
+  constexpr uint8_t strokeAt(uint16_t n, uint16_t g) { return strokeOf(g, n - offsets.data[g], popcount(covers.glyph[g].h)); }
+
+  constexpr uint8_t strokeAt(uint16_t n) { return strokeAt(n, glyphAt(n)); }
+
+  template <uint16_t N>
+  struct Table {
+    uint8_t data[N];
+  };
+
+  template <uint16_t... Is>
+  constexpr Table<sizeof...(Is)> buildStrokes(Seq<Is...>) {
+    return Table<sizeof...(Is)>{{strokeAt(Is)...}};
+  }
+
+} // namespace SSD1353Strokes
+
+#define SSD1353_STROKES SSD1353Strokes::offsets.data[SSD1353_GLYPHS]
+
+// Packed strokes of every glyph, glyph g owns entries ssd1353StrokeIndex[g] to ssd1353StrokeIndex[g + 1] - 1
+static constexpr SSD1353Strokes::Table<SSD1353_STROKES> ssd1353Strokes PROGMEM = SSD1353Strokes::buildStrokes(SSD1353Strokes::MakeSeq<SSD1353_STROKES>::type());
+static constexpr SSD1353Strokes::Offsets<SSD1353_GLYPHS + 1> ssd1353StrokeIndex PROGMEM = SSD1353Strokes::offsets;
+
+#endif
@@ -0,0 +1,202 @@
+/*
+  SSD1353T.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353T_H
+#define SSD1353T_H
+
+#include "SSD1353.h"
+
+// Compile-time pin to port register maps. The values are the data space
+// addresses of the PORTx registers, so writes fold into sbi/cbi/out/sts.
+namespace SSD1353Pins {
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega328PB__) || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168__) || defined(__AVR_ATmega168P__)
+#define SSD1353_CONST_PINS
+  // Pins 0-7 PORTD, 8-13 PORTB, 14-19 PORTC
+  constexpr uint16_t port(uint8_t pin) { return pin < 8 ? 0x2B : pin < 14 ? 0x25 : 0x28; }
+  constexpr uint8_t bit(uint8_t pin) { return pin < 8 ? pin : pin < 14 ? pin - 8 : pin - 14; }
+
+#elif defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__)
+#define SSD1353_CONST_PINS
+  // Port letter index (A, B, C, D, E, F, G, H, J, K, L) in the high nibble, bit in the low nibble
+  constexpr uint8_t map[] = {
+      0x40, 0x41, 0x44, 0x45, 0x65, 0x43, 0x73, 0x74, 0x75, 0x76, // 0-9
+      0x14, 0x15, 0x16, 0x17, 0x81, 0x80, 0x71, 0x70, 0x33, 0x32, // 10-19
+      0x31, 0x30, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 20-29
+      0x27, 0x26, 0x25, 0x24, 0x23, 0x22, 0x21, 0x20, 0x37, 0x62, // 30-39
+      0x61, 0x60, 0xA7, 0xA6, 0xA5, 0xA4, 0xA3, 0xA2, 0xA1, 0xA0, // 40-49
+      0x13, 0x12, 0x11, 0x10, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, // 50-59
+      0x56, 0x57, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97  // 60-69
+  };
+  constexpr uint16_t port(uint8_t pin) { return (map[pin] >> 4) < 7 ? 0x22 + 3 * (map[pin] >> 4) : 0x102 + 3 * ((map[pin] >> 4) - 7); }
+  constexpr uint8_t bit(uint8_t pin) { return map[pin] & 0x0F; }
+#endif
+} // namespace SSD1353Pins
+
+/**
+ * @brief SSD1353 driver with the bus pins fixed at compile time
+ *
+ * @tparam CS Display pin CS
+ * @tparam DC Display pin DC
+ * @tparam RS Display pin RS
+ * @tparam DISF Display pin DISF
+ * @tparam D0 Display pin D0
+ * @tparam D1 Display pin D1
+ * @tparam D2 Display pin D2
+ * @tparam D3 Display pin D3
+ * @tparam D4 Display pin D4
+ * @tparam D5 Display pin D5
+ * @tparam D6 Display pin D6
+ * @tparam D7 Display pin D7
+ */
+template <uint8_t CS, uint8_t DC, uint8_t RS, uint8_t DISF, uint8_t D0, uint8_t D1, uint8_t D2, uint8_t D3, uint8_t D4, uint8_t D5, uint8_t D6, uint8_t D7>
+class SSD1353T : public SSD1353Base {
+  public:
+  /**
+   * @brief SSD1353 initialization function
+   *
+   */
+  void init() {
+    pinMode(CS, OUTPUT);
+    pinMode(DC, OUTPUT);
+    pinMode(RS, OUTPUT);
+    pinMode(DISF, OUTPUT);
+    for (uint8_t i = 0; i < 8; i++)
+      pinMode(dataPin(i), OUTPUT);
+
+    // Display reset sequence
+    digitalWrite(DISF, LOW);
+    digitalWrite(RS, LOW);
+    delay(10);
+    digitalWrite(RS, HIGH);
+    delay(10);
+
+    initSequence();
+    digitalWrite(DISF, HIGH);
+  }
+
+#ifdef SSD1353_CONST_PINS
+  // A handful of single-cycle port writes per byte
+  uint16_t busByteNanos() const { return contiguous() ? 250 : 1000; }
+#endif
+
+  protected:
+  /**
+   * @brief Write data to driver
+   *
+   * @param data Pointer to the bytes to be written
+   * @param length Number of bytes
+   * @param isCommand Bytes are commands, true/false
+   */
+  void busWrite(const uint8_t* data, uint16_t length, bool isCommand) {
+    setPin<DC>(!isCommand);
+    for (uint16_t n = 0; n < length; n++) {
+      setPin<CS>(false);
+      writeBus(data[n]);
+      setPin<CS>(true);
+    }
+  }
+
+  private:
+  static constexpr uint8_t dataPin(uint8_t i) {
+    return i == 0 ? D0 : i == 1 ? D1 : i == 2 ? D2 : i == 3 ? D3 : i == 4 ? D4 : i == 5 ? D5 : i == 6 ? D6 : D7;
+  }
+
+#ifdef SSD1353_CONST_PINS
+  static constexpr bool contiguous(uint8_t i = 1) {
+    return i == 8 || (SSD1353Pins::port(dataPin(i)) == SSD1353Pins::port(D0) && SSD1353Pins::bit(dataPin(i)) == SSD1353Pins::bit(D0) + i && contiguous(i + 1));
+  }
+
+  static constexpr bool firstOnPort(uint8_t i, uint8_t j = 0) {
+    return j == i || (SSD1353Pins::port(dataPin(j)) != SSD1353Pins::port(dataPin(i)) && firstOnPort(i, j + 1));
+  }
+
+  static constexpr uint8_t portMask(uint16_t port, uint8_t j = 0) {
+    return j == 8 ? 0 : (SSD1353Pins::port(dataPin(j)) == port ? 1 << SSD1353Pins::bit(dataPin(j)) : 0) | portMask(port, j + 1);
+  }
+
+  static inline volatile uint8_t& reg(uint16_t address) {
+    return *(volatile uint8_t*)address;
+  }
+
+  template <uint8_t Pin>
+  static inline void setPin(bool value) {
+    if (value)
+      reg(SSD1353Pins::port(Pin)) |= 1 << SSD1353Pins::bit(Pin);
+    else
+      reg(SSD1353Pins::port(Pin)) &= ~(1 << SSD1353Pins::bit(Pin));
+  }
+
+  // Bit j of data moved to its place on the port of data line i, or 0 if on another port
+  template <uint8_t I, uint8_t J>
+  static inline uint8_t portBit(uint8_t data) {
+    return SSD1353Pins::port(dataPin(J)) == SSD1353Pins::port(dataPin(I)) ? ((data >> J) & 1) << SSD1353Pins::bit(dataPin(J)) : 0;
+  }
+
+  // Masked write of every data line sharing a port with data line i, done once per port
+  template <uint8_t I>
+  static inline void writePort(uint8_t data) {
+    if (!firstOnPort(I))
+      return;
+    uint8_t set = portBit<I, 0>(data) | portBit<I, 1>(data) | portBit<I, 2>(data) | portBit<I, 3>(data) |
+                  portBit<I, 4>(data) | portBit<I, 5>(data) | portBit<I, 6>(data) | portBit<I, 7>(data);
+    volatile uint8_t& out = reg(SSD1353Pins::port(dataPin(I)));
+    out = (out & ~portMask(SSD1353Pins::port(dataPin(I)))) | set;
+  }
+
+  static inline void writeBus(uint8_t data) {
+    if (contiguous()) {
+      // D0-D7 fill a whole port, the byte goes out in a single store
+      reg(SSD1353Pins::port(D0)) = data;
+      return;
+    }
+    writePort<0>(data);
+    writePort<1>(data);
+    writePort<2>(data);
+    writePort<3>(data);
+    writePort<4>(data);
+    writePort<5>(data);
+    writePort<6>(data);
+    writePort<7>(data);
+  }
+#else
+  // No compile-time pin map for this board, pin lookups are left to the core
+  template <uint8_t Pin>
+  static inline void setPin(bool value) {
+#ifdef SSD1353_FAST_BUS
+    SSD1353_PORT_REG out = (SSD1353_PORT_REG)portOutputRegister(digitalPinToPort(Pin));
+    SSD1353_PORT_T mask  = digitalPinToBitMask(Pin);
+    if (value)
+      *out = *out | mask;
+    else
+      *out = *out & ~mask;
+#else
+    digitalWrite(Pin, value);
+#endif
+  }
+
+  static inline void writeBus(uint8_t data) {
+    setPin<D0>(data & 0x01);
+    setPin<D1>(data & 0x02);
+    setPin<D2>(data & 0x04);
+    setPin<D3>(data & 0x08);
+    setPin<D4>(data & 0x10);
+    setPin<D5>(data & 0x20);
+    setPin<D6>(data & 0x40);
+    setPin<D7>(data & 0x80);
+  }
+#endif
+};
+
+#endif
@@ -0,0 +1,155 @@
+/*
+  SSD1353TextField.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353TextField.h"
+#include <Arduino.h>
+
+/**
+ * @brief Construct a text field
+ *
+ * The field starts invalidated, so the first print draws every cell.
+ *
+ * @param display Surface the field is drawn on
+ * @param buffer Storage for the displayed text, at least width + 1 bytes
+ * @param width Field width in characters
+ * @param x Field bottom left corner X coordinate
+ * @param y Field bottom left corner Y coordinate
+ */
+SSD1353TextField::SSD1353TextField(SSD1353Gfx& display, char* buffer, uint8_t width, uint8_t x, uint8_t y)
+    : _display(display), _text(buffer), _width(width), _x(x), _y(y) {
+  memset(_text, ' ', _width);
+  _text[_width] = '\0';
+}
+
+/**
+ * @brief Set the text and background colors
+ *
+ * Changing a color redraws the whole field on the next print.
+ *
+ * @param valueRed Text color red value
+ * @param valueGreen Text color green value
+ * @param valueBlue Text color blue value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353TextField::setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  const uint8_t colors[6] = {valueRed, valueGreen, valueBlue, backgroundRed, backgroundGreen, backgroundBlue};
+  if (memcmp(colors, _color, 3) == 0 && memcmp(colors + 3, _background, 3) == 0)
+    return;
+
+  memcpy(_color, colors, 3);
+  memcpy(_background, colors + 3, 3);
+  _valid = false;
+}
+
+/**
+ * @brief Move the field
+ *
+ * The old area is left as is, the whole field is redrawn on the next print.
+ *
+ * @param x Field bottom left corner X coordinate
+ * @param y Field bottom left corner Y coordinate
+ */
+void SSD1353TextField::setPosition(uint8_t x, uint8_t y) {
+  _x     = x;
+  _y     = y;
+  _valid = false;
+}
+
+/**
+ * @brief Show a string in the field
+ *
+ * Text shorter than the field is padded with spaces, longer text is cut.
+ *
+ * @param input String to be shown
+ * @return Number of character cells that were redrawn
+ */
+uint8_t SSD1353TextField::print(const char* input) {
+  uint8_t drawn = 0;
+  bool ended    = false;
+
+  for (uint8_t i = 0; i < _width; i++) {
+    if (!ended && input[i] == '\0')
+      ended = true;
+    if (drawCell(i, ended ? ' ' : input[i]))
+      drawn++;
+  }
+  _valid = true;
+  return drawn;
+}
+
+/**
+ * @brief Show a number right aligned in the field
+ *
+ * A number wider than the field fills it with '#' instead, so it is never
+ * mistaken for a cut reading.
+ *
+ * @param value Number to be shown
+ * @return Number of character cells that were redrawn
+ */
+uint8_t SSD1353TextField::print(long value) {
+  char digits[12];
+  uint8_t length     = 0;
+  unsigned long rest = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+
+  do {
+    digits[length++] = '0' + rest % 10;
+    rest /= 10;
+  } while (rest > 0);
+  if (value < 0)
+    digits[length++] = '-';
+
+  bool overflow = length > _width;
+  uint8_t drawn = 0;
+  for (uint8_t i = 0; i < _width; i++) {
+    uint8_t fromRight = _width - 1 - i;
+    if (drawCell(i, overflow ? '#' : fromRight < length ? digits[fromRight] : ' '))
+      drawn++;
+  }
+  _valid = true;
+  return drawn;
+}
+
+/**
+ * @brief Blank the field
+ *
+ * @return Number of character cells that were redrawn
+ */
+uint8_t SSD1353TextField::clear() {
+  return print("");
+}
+
+/**
+ * @brief Draw one character cell if it differs from what is shown
+ *
+ * Cells past the right edge of the display are kept in the text but not
+ * drawn, as printstr does.
+ *
+ * @param i Cell index
+ * @param character Character for the cell
+ * @return Cell was redrawn, true/false
+ */
+bool SSD1353TextField::drawCell(uint8_t i, char character) {
+  if (_valid && _text[i] == character)
+    return false;
+
+  _text[i]       = character;
+  uint16_t cellX = _x + i * 6;
+  if (cellX >= SSD1353_WIDTH)
+    return false;
+  _display.printchar(cellX, _y, character, _color[0], _color[1], _color[2], _background[0], _background[1], _background[2]);
+  return true;
+}
@@ -0,0 +1,50 @@
+/*
+  SSD1353TextField.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353TEXTFIELD_H
+#define SSD1353TEXTFIELD_H
+
+#include "SSD1353.h"
+
+// Fixed width line of text that redraws only the characters that changed
+class SSD1353TextField {
+  public:
+  SSD1353TextField(SSD1353Gfx& display, char* buffer, uint8_t width, uint8_t x, uint8_t y);
+
+  void setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+  void setPosition(uint8_t x, uint8_t y);
+  uint8_t print(const char* input);
+  uint8_t print(long value);
+  uint8_t print(int value) { return print((long)value); }
+  uint8_t clear();
+  void invalidate() { _valid = false; }
+
+  uint8_t width() const { return _width; }
+  const char* text() const { return _text; } // Shown text, width characters and a NUL
+
+  private:
+  SSD1353Gfx& _display;
+  char* _text;
+  uint8_t _width;
+  uint8_t _x;
+  uint8_t _y;
+  uint8_t _color[3]      = {0x3F, 0x3F, 0x3F};
+  uint8_t _background[3] = {0, 0, 0};
+  bool _valid            = false;
+
+  bool drawCell(uint8_t i, char character);
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+  SSD1353Ticker.cpp -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SSD1353Ticker.h"
+#include <Arduino.h>
+
+/**
+ * @brief Construct a ticker
+ *
+ * @param display Display the ticker is drawn on
+ * @param y Ticker band bottom row
+ * @param step Columns moved per scroll step, negative values move the other way
+ * @param interval Frames per step, SSD1353_SCROLL_6_FRAMES to SSD1353_SCROLL_200_FRAMES
+ */
+SSD1353Ticker::SSD1353Ticker(SSD1353Base& display, uint8_t y, int8_t step, uint8_t interval)
+    : _display(display), _y(y), _step(step), _interval(interval) {}
+
+/**
+ * @brief Set the text and background colors, used from the next show()
+ *
+ * @param valueRed Text color red value
+ * @param valueGreen Text color green value
+ * @param valueBlue Text color blue value
+ * @param backgroundRed Background red color value
+ * @param backgroundGreen Background green color value
+ * @param backgroundBlue Background blue color value
+ */
+void SSD1353Ticker::setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue) {
+  _color[0]      = valueRed;
+  _color[1]      = valueGreen;
+  _color[2]      = valueBlue;
+  _background[0] = backgroundRed;
+  _background[1] = backgroundGreen;
+  _background[2] = backgroundBlue;
+}
+
+/**
+ * @brief Change the scroll speed, a running ticker is restarted
+ *
+ * @param step Columns moved per scroll step, negative values move the other way
+ * @param interval Frames per step, SSD1353_SCROLL_6_FRAMES to SSD1353_SCROLL_200_FRAMES
+ */
+void SSD1353Ticker::setSpeed(int8_t step, uint8_t interval) {
+  _step     = step;
+  _interval = interval;
+  if (_display.scrolling())
+    start();
+}
+
+/**
+ * @brief Draw a new text in the band and start it moving
+ *
+ * Only the first SSD1353_TICKER_COLUMNS characters fit the band.
+ *
+ * @param text Text to be shown
+ */
+void SSD1353Ticker::show(const char* text) {
+  _display.stopScroll();
+  _display.drawRectangle(0, _y, SSD1353_WIDTH - 1, _y + 7, _background[0], _background[1], _background[2], _background[0], _background[1], _background[2], true);
+  for (uint8_t i = 0; i < SSD1353_TICKER_COLUMNS && text[i] != '\0'; i++)
+    _display.printchar(i * 6, _y, text[i], _color[0], _color[1], _color[2]);
+  start();
+}
+
+/**
+ * @brief Start or restart the scrolling
+ *
+ */
+void SSD1353Ticker::start() {
+  _display.startScroll(_y, 8, _step, 0, _interval);
+}
+
+/**
+ * @brief Stop the scrolling
+ *
+ * The band has to be redrawn with show() after this.
+ */
+void SSD1353Ticker::stop() {
+  _display.stopScroll();
+}
@@ -0,0 +1,44 @@
+/*
+  SSD1353Ticker.h -
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SSD1353TICKER_H
+#define SSD1353TICKER_H
+
+#include "SSD1353.h"
+
+// Characters that fit the ticker band, the text wraps around the display width
+#define SSD1353_TICKER_COLUMNS (SSD1353_WIDTH / 6)
+
+// One text row that the controller scrolls around on its own
+class SSD1353Ticker {
+  public:
+  SSD1353Ticker(SSD1353Base& display, uint8_t y, int8_t step = -1, uint8_t interval = SSD1353_SCROLL_6_FRAMES);
+
+  void setColors(uint8_t valueRed, uint8_t valueGreen, uint8_t valueBlue, uint8_t backgroundRed, uint8_t backgroundGreen, uint8_t backgroundBlue);
+  void setSpeed(int8_t step, uint8_t interval);
+  void show(const char* text);
+  void start();
+  void stop();
+
+  private:
+  SSD1353Base& _display;
+  uint8_t _y;
+  int8_t _step;
+  uint8_t _interval;
+  uint8_t _color[3]      = {0x3F, 0x3F, 0x3F};
+  uint8_t _background[3] = {0, 0, 0};
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include <Arduino.h>
 
 #include "SSD1353.h"
+#include "SSD1353Gamma.h"
 
 SSD1353 lcd; // Create object 'lcd' of type 'SSD1353'
 
@@ -24,6 +25,9 @@ SSD1353 lcd; // Create object 'lcd' of type 'SSD1353'
 void setup() {
   // Initialize the display
   lcd.init(CS, DC, RS, DISF, D0, D1, D2, D3, D4, D5, D6, D7);
+
+  // Make the linear color steps below look evenly spaced
+  lcd.setGammaTable(ssd1353Gamma22.data);
 }
 
 void loop() {
@@ -0,0 +1,569 @@
+/*
+  Benchmark.cpp - Bus cycle benchmarks for the SSD1353 and WizFi360Custom libraries
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HostSim.h"
+#include <Arduino.h>
+
+#include "SSD1353.h"
+#include "SSD1353Canvas.h"
+#include "SSD1353Chart.h"
+#include "SSD1353Console.h"
+#include "SSD1353DisplayList.h"
+#include "SSD1353FrameDiff.h"
+#include "SSD1353Group.h"
+#include "SSD1353Gamma.h"
+#include "SSD1353Image.h"
+#include "SSD1353Queue.h"
+#include "SSD1353SPI.h"
+#include "SSD1353Shadow.h"
+#include "SSD1353T.h"
+#include "SSD1353TextField.h"
+#include "SSD1353Ticker.h"
+#include "WizFi360Custom.h"
+
+// Same wiring as the SSD1353 examples
+#define CS   2
+#define DC   3
+#define RS   4
+#define DISF 5
+#define D0   6
+#define D1   7
+#define D2   8
+#define D3   9
+#define D4   10
+#define D5   11
+#define D6   12
+#define D7   13
+
+// Second panel sharing DC, RS and D0-D7, its CS on the same port as the first
+#define CS2   0
+#define DISF2 1
+
+#define WIZFI_RST 20
+
+static const uint8_t dataPins[] = {D0, D1, D2, D3, D4, D5, D6, D7};
+
+// Rows printed by the PrintAllCharacters example
+static const char* const charRows[] = {
+    "ABCDEFGHIJKLM", "NOPQRSTUVWXYZ", "abcdefghijklm", "nopqrstuvwxyz",
+    "0123456789&'(", ")*+-=.!\"#$%^,", ":;?@/<>|\\[]{}", "_~"};
+
+static bool csv;
+static unsigned long startClock;
+
+static void begin() {
+  hostResetCounters();
+  startClock = hostClock();
+}
+
+// Let the drawing engine finish the previous benchmark's work first
+static void begin(SSD1353Base& lcd) {
+  lcd.waitIdle();
+  begin();
+}
+
+// A group and both its panels idle first
+static void begin(SSD1353Base& group, SSD1353Base& first, SSD1353Base& second) {
+  group.waitIdle();
+  first.waitIdle();
+  second.waitIdle();
+  begin();
+}
+
+/**
+ * @brief Print the counters collected since begin()
+ *
+ * @param group Benchmark group
+ * @param name Benchmark name
+ * @param runs Number of repetitions to average over
+ */
+static void report(const char* group, const char* name, uint32_t runs) {
+  double bytes    = (double)hostCounters.busBytes / runs;
+  double commands = (double)hostCounters.busCommands / runs;
+  double edges    = (double)hostCounters.pinEdges / runs;
+  double delayMs  = hostCounters.delayMicros / 1000.0 / runs;
+  double timeMs   = (hostClock() - startClock) / 1000.0 / runs;
+
+  if (csv)
+    printf("%s,%s,%.2f,%.2f,%.2f,%.3f,%.3f\n", group, name, bytes, commands, edges, delayMs, timeMs);
+  else
+    printf("%-10s %-24s %10.2f %10.2f %12.2f %10.3f %10.3f\n", group, name, bytes, commands, edges, delayMs, timeMs);
+}
+
+static void header() {
+  if (csv)
+    printf("group,benchmark,bus_bytes,commands,pin_edges,delay_ms,sim_time_ms\n");
+  else
+    printf("%-10s %-24s %10s %10s %12s %10s %10s\n", "group", "benchmark", "bus bytes", "commands", "pin edges", "delay ms", "time ms");
+}
+
+/**
+ * @brief Run the drawing benchmarks on an initialized display
+ *
+ * @param lcd Display under test
+ * @param group Benchmark group name
+ */
+static void benchDrawing(SSD1353Base& lcd, const char* group) {
+  begin(lcd);
+  lcd.fill(0x3F, 0x10, 0);
+  report(group, "fill", 1);
+
+  begin(lcd);
+  lcd.clear();
+  report(group, "clear", 1);
+
+  begin(lcd);
+  lcd.drawLine(0, 0, 159, 127, 0x3F, 0x3F, 0x3F);
+  report(group, "drawLine", 1);
+
+  begin(lcd);
+  lcd.drawDot(80, 64, 0x3F, 0, 0);
+  report(group, "drawDot", 1);
+
+  begin(lcd);
+  lcd.drawRectangle(10, 10, 149, 117, 0x3F, 0, 0, 0, 0, 0, false);
+  report(group, "drawRectangle", 1);
+
+  begin(lcd);
+  lcd.drawRectangle(10, 10, 149, 117, 0x3F, 0, 0, 0, 0x3F, 0, true);
+  report(group, "drawRectangle filled", 1);
+
+  uint32_t glyphs = 0;
+  begin(lcd);
+  for (char c = '!'; c <= '~'; c++, glyphs++)
+    lcd.printchar(0, 0, c, 0x3F, 0x3F, 0x3F);
+  report(group, "printchar (per glyph)", glyphs);
+
+  glyphs = 0;
+  begin(lcd);
+  for (uint8_t row = 0; row < sizeof(charRows) / sizeof(charRows[0]); row++) {
+    lcd.printstr(charRows[row], 0, 120 - row * 8, 0x3F, 0x3F, 0x3F);
+    glyphs += strlen(charRows[row]);
+  }
+  report(group, "printstr (per glyph)", glyphs);
+
+  glyphs = 0;
+  begin(lcd);
+  for (uint8_t row = 0; row < sizeof(charRows) / sizeof(charRows[0]); row++) {
+    lcd.printstr(charRows[row], 0, 120 - row * 8, 0x3F, 0x3F, 0x3F, 0, 0, 0);
+    glyphs += strlen(charRows[row]);
+  }
+  report(group, "printstr bg (per glyph)", glyphs);
+
+  // 32x32 gradient, one dot per pixel versus one window write
+  static uint16_t gradient[32 * 32];
+  begin(lcd);
+  for (uint8_t y = 0; y < 32; y++)
+    for (uint8_t x = 0; x < 32; x++) {
+      gradient[y * 32 + x] = SSD1353_RGB(x * 2, y * 2, 0x3F - x - y);
+      lcd.drawDot(x, y, x * 2, y * 2, 0x3F - x - y);
+    }
+  report(group, "gradient 32x32 drawDot", 1);
+
+  begin(lcd);
+  lcd.drawBitmap(0, 0, 32, 32, gradient);
+  report(group, "gradient 32x32 bitmap", 1);
+
+  // Two-color 32x32 icon, run-length encoded with a palette
+  static uint8_t icon[SSD1353_IMAGE_HEADER + 4 + 32 * 4] = {32, 32, 2, 0x00, 0x00, 0xE0, 0x07};
+  for (uint8_t y = 0; y < 32; y++) {
+    uint8_t* row = icon + SSD1353_IMAGE_HEADER + 4 + y * 4;
+    row[0]       = SSD1353_IMAGE_RUN | (y / 2);
+    row[1]       = 0;
+    row[2]       = SSD1353_IMAGE_RUN | (31 - y / 2);
+    row[3]       = 1;
+  }
+  begin(lcd);
+  lcd.drawImage(0, 0, icon);
+  report(group, "icon 32x32 rle image", 1);
+
+  static SSD1353Framebuffer frame;
+  frame.fill(0, 0, 0x3F);
+  frame.printstr("FRAMEBUFFER", 10, 60, 0x3F, 0x3F, 0x3F);
+  begin(lcd);
+  frame.flush(lcd);
+  report(group, "framebuffer flush", 1);
+
+  // Dashboard counter update through the dirty-rectangle shadow
+  SSD1353Shadow shadow(lcd, frame);
+  shadow.flushAll();
+  begin(lcd);
+  shadow.drawRectangle(70, 30, 87, 37, 0, 0, 0x3F, 0, 0, 0x3F, true);
+  shadow.printstr("123", 70, 30, 0x3F, 0x3F, 0x3F);
+  shadow.flush();
+  report(group, "shadow counter update", 1);
+
+  // Next animation frame: a progress bar grows, a marker moves, text changes
+  static SSD1353Framebuffer nextFrame;
+  memcpy(nextFrame.buffer(), frame.buffer(), sizeof(uint16_t) * SSD1353_WIDTH * SSD1353_HEIGHT);
+  nextFrame.drawRectangle(10, 100, 90, 107, 0x3F, 0x3F, 0, 0x3F, 0x3F, 0, true);
+  nextFrame.drawRectangle(20, 20, 27, 27, 0, 0, 0x3F, 0, 0, 0x3F, true);
+  nextFrame.drawRectangle(28, 20, 35, 27, 0x3F, 0, 0, 0x3F, 0, 0, true);
+  nextFrame.drawLine(0, 115, 159, 115, 0, 0x3F, 0);
+  nextFrame.printstr("FRAMEBUFFER 2", 10, 60, 0x3F, 0x3F, 0x3F, 0, 0, 0x3F);
+  begin(lcd);
+  nextFrame.flush(lcd);
+  report(group, "animation frame flush", 1);
+
+  SSD1353FrameDiff diff(lcd);
+  begin(lcd);
+  diff.update(frame, nextFrame);
+  report(group, "animation frame diff", 1);
+
+  // ColorTunnel loop body without its delay(5)
+  begin(lcd);
+  for (uint8_t i = 63; i > 0; i--)
+    lcd.drawRectangle(i, i, 159 - i, 127 - i, 0x3F, 0x20, 0, 0, 0, 0, false);
+  report(group, "color tunnel frame", 1);
+
+  // Sensor reading re-printed every cycle, one digit changes
+  begin(lcd);
+  lcd.printstr("T: 1234", 0, 10, 0x3F, 0x3F, 0x3F, 0, 0, 0);
+  lcd.printstr("T: 1235", 0, 10, 0x3F, 0x3F, 0x3F, 0, 0, 0);
+  report(group, "counter printstr bg", 1);
+
+  char fieldText[8 + 1];
+  SSD1353TextField field(lcd, fieldText, sizeof(fieldText) - 1, 0, 10);
+  field.print(1234L);
+  begin(lcd);
+  field.print(1235L);
+  report(group, "counter text field", 1);
+
+  // Event log scrolled by one line: full reprint versus console copy
+  static const char* logLine = "12:00:01 door opened";
+  begin(lcd);
+  lcd.clear();
+  for (uint8_t row = 0; row < 16; row++)
+    lcd.printstr(logLine, 0, row * 8, 0x3F, 0x3F, 0x3F, 0, 0, 0);
+  report(group, "log line reprint", 1);
+
+  SSD1353Console console(lcd, 0, 0, 26, 16);
+  console.clear();
+  for (uint8_t row = 0; row < 16; row++)
+    console.println(logLine);
+  begin(lcd);
+  console.println(logLine);
+  report(group, "log line console", 1);
+
+  // Marquee: one CPU redraw per step versus the controller's scrolling
+  static const char* news = "+++ SENSOR 3 OFFLINE +++";
+  begin(lcd);
+  lcd.printstr(news, 1, 100, 0x3F, 0x3F, 0, 0, 0, 0);
+  report(group, "marquee step printstr bg", 1);
+
+  SSD1353Ticker ticker(lcd, 100);
+  begin(lcd);
+  ticker.show(news);
+  report(group, "ticker show", 1);
+  ticker.stop();
+
+  // Sensor graph, 128 samples of history: full repaint versus strip chart
+  static int16_t history[128];
+  for (uint8_t i = 0; i < 128; i++)
+    history[i] = 512 + (i * 37) % 400 - 200;
+  begin(lcd);
+  lcd.drawRectangle(16, 0, 143, 63, 0, 0, 0, 0, 0, 0, true);
+  for (uint8_t i = 1; i < 128; i++)
+    lcd.drawLine(15 + i, history[i - 1] / 16, 16 + i, history[i] / 16, 0, 0x3F, 0);
+  report(group, "graph repaint", 1);
+
+  SSD1353Chart chart(lcd, 16, 0, 128, 64);
+  chart.setGrid(16, 32, 0, 0x10, 0);
+  chart.addTrace(0, 0x3F, 0);
+  chart.addTrace(0x3F, 0x20, 0);
+  chart.clear();
+  int16_t sample[2] = {600, 300};
+  chart.plot(sample);
+  begin(lcd);
+  chart.plot(sample);
+  report(group, "chart sample 2 traces", 1);
+
+  // Scrolled list, 16 rows with only a 48 pixel high viewport showing
+  begin(lcd);
+  for (uint8_t row = 0; row < 16; row++)
+    lcd.printstr(logLine, 0, row * 8 + 3, 0x3F, 0x3F, 0x3F, 0, 0, 0x10);
+  report(group, "list 16 rows", 1);
+
+  lcd.pushClip(0, 40, 159, 87);
+  begin(lcd);
+  for (uint8_t row = 0; row < 16; row++)
+    lcd.printstr(logLine, 0, row * 8 + 3, 0x3F, 0x3F, 0x3F, 0, 0, 0x10);
+  report(group, "list 16 rows clipped", 1);
+  lcd.popClip();
+
+  // Round gauge face: a dot per pixel versus rasterized spans
+  begin(lcd);
+  for (int8_t dy = -30; dy <= 30; dy++)
+    for (int8_t dx = -30; dx <= 30; dx++)
+      if (dx * dx + dy * dy <= 30 * 30 + 30)
+        lcd.drawDot(80 + dx, 64 + dy, 0, 0x20, 0x3F);
+  report(group, "gauge r30 dots", 1);
+
+  begin(lcd);
+  lcd.drawCircle(80, 64, 30, 0x3F, 0x3F, 0x3F, 0, 0x20, 0x3F, true);
+  report(group, "gauge r30 circle", 1);
+
+  begin(lcd);
+  lcd.drawRoundRect(20, 20, 139, 50, 8, 0x3F, 0x3F, 0x3F, 0, 0, 0x20, true);
+  lcd.drawTriangle(80, 90, 70, 70, 90, 70, 0x3F, 0, 0, 0x3F, 0, 0, true);
+  report(group, "button and arrow", 1);
+
+  // Dashboard built from small primitives, replayed as recorded and optimized
+  static uint8_t uiBuffer[4096];
+  SSD1353DisplayList ui(uiBuffer, sizeof(uiBuffer));
+  ui.fill(0, 0, 0x10);
+  for (uint8_t i = 0; i < 8; i++) {
+    // Bar graph drawn one line per column, framed alternately filled and outlined
+    for (uint8_t x = 0; x < 12; x++)
+      ui.drawLine(8 + i * 18 + x, 10, 8 + i * 18 + x, 20 + i * 10, 0, 0x3F, 0);
+    ui.drawRectangle(6 + i * 18, 100, 21 + i * 18, 110, 0x3F, 0x3F, 0x3F, 0x20, 0x20, 0x20, i % 2);
+  }
+  for (uint8_t x = 0; x < 160; x += 2)
+    ui.drawDot(x, 5, 0x3F, 0x3F, 0);
+  for (uint8_t x = 0; x < 160; x++)
+    ui.drawDot(x, 120, 0x3F, 0, 0);
+  ui.printstr("ZONE 1", 60, 112, 0x3F, 0x3F, 0x3F);
+  begin(lcd);
+  ui.replay(lcd);
+  report(group, "dashboard replay", 1);
+
+  ui.optimize();
+  begin(lcd);
+  ui.replay(lcd);
+  report(group, "dashboard optimized", 1);
+
+  // Same frame through the asynchronous queue: the draw calls only queue,
+  // poll() sends it later without waiting on the drawing engine
+  static uint8_t queueBuffer[2048];
+  static SSD1353Queue queue(queueBuffer, sizeof(queueBuffer));
+  lcd.beginAsync(queue);
+  begin(lcd);
+  ui.replay(lcd);
+  report(group, "dashboard queued", 1);
+
+  begin();
+  while (lcd.poll())
+    ;
+  report(group, "dashboard polled", 1);
+  lcd.endAsync();
+
+  // PrintAllCharacters frame composed in 160x4 strips
+  static uint8_t listBuffer[1024];
+  static uint16_t stripBuffer[SSD1353_WIDTH * 4];
+  SSD1353DisplayList list(listBuffer, sizeof(listBuffer));
+  SSD1353Canvas strip(stripBuffer, SSD1353_WIDTH, 4);
+  list.drawRectangle(0, 0, 159, 60, 0x3F, 0, 0, 0, 0, 0x10, true);
+  for (uint8_t row = 0; row < sizeof(charRows) / sizeof(charRows[0]); row++)
+    list.printstr(charRows[row], 0, 120 - row * 8, 0x3F, 0x3F, 0x3F);
+  begin(lcd);
+  list.renderBands(lcd, strip);
+  report(group, "banded frame 160x4", 1);
+
+  for (uint8_t row = 0; row < sizeof(charRows) / sizeof(charRows[0]); row++) {
+    char name[32];
+    snprintf(name, sizeof(name), "printstr row %u", row + 1);
+    begin(lcd);
+    lcd.printstr(charRows[row], 0, 120 - row * 8, 0x3F, 0x3F, 0x3F);
+    report(group, name, 1);
+  }
+}
+
+/**
+ * @brief Run the pixel transfer benchmarks in 65k color mode
+ *
+ * @param lcd Display under test
+ * @param group Benchmark group name
+ */
+static void benchColor65k(SSD1353Base& lcd, const char* group) {
+  static constexpr Color565 text(255, 255, 255);
+  static constexpr Color565 background(0, 0, 128);
+  static SSD1353Framebuffer frame;
+
+  lcd.setColorDepth(SSD1353_COLOR_65K);
+  frame.fill(background);
+  frame.printstr("FRAMEBUFFER", 10, 60, text);
+  begin(lcd);
+  frame.flush(lcd);
+  report(group, "framebuffer flush 65k", 1);
+
+  uint16_t glyphs = 0;
+  begin(lcd);
+  for (uint8_t row = 0; row < sizeof(charRows) / sizeof(charRows[0]); row++) {
+    lcd.printstr(charRows[row], 0, 120 - row * 8, text, background);
+    glyphs += strlen(charRows[row]);
+  }
+  report(group, "printstr bg 65k (per glyph)", glyphs);
+  lcd.setColorDepth(SSD1353_COLOR_262K);
+}
+
+#ifdef SSD1353_STATS
+/**
+ * @brief Print the driver's own counters, collected since init
+ *
+ * @param lcd Display
+ * @param group Benchmark group
+ */
+static void reportStats(SSD1353Base& lcd, const char* group) {
+  static const char* const names[] = {"drawLine", "drawRectangle", "printchar", "fill"};
+  const SSD1353Stats& stats        = lcd.stats();
+
+  printf("%s stats: %lu commands, %lu data bytes, %lu fills, %lu us waiting\n", group, (unsigned long)stats.commands,
+         (unsigned long)stats.dataBytes, (unsigned long)stats.fills, (unsigned long)stats.waitMicros);
+  for (uint8_t i = 0; i < SSD1353_STAT_PRIMITIVES; i++)
+    printf("%s stats: %-14s %8lu calls %10lu us\n", group, names[i], (unsigned long)stats.calls[i], (unsigned long)stats.micros[i]);
+}
+#endif
+
+static void benchSSD1353() {
+  static SSD1353 lcd;
+  hostWatchParallelBus(CS, DC, dataPins, nullptr);
+
+  begin();
+  lcd.init(CS, DC, RS, DISF, D0, D1, D2, D3, D4, D5, D6, D7);
+  report("SSD1353", "init", 1);
+
+  begin(lcd);
+  lcd.setGammaTable(ssd1353Gamma22.data);
+  report("SSD1353", "setGammaTable", 1);
+
+  benchDrawing(lcd, "SSD1353");
+  benchColor65k(lcd, "SSD1353");
+  hostUnwatchBuses();
+#ifdef SSD1353_STATS
+  reportStats(lcd, "SSD1353");
+#endif
+}
+
+static void benchSSD1353T() {
+  static SSD1353T<CS, DC, RS, DISF, D0, D1, D2, D3, D4, D5, D6, D7> lcd;
+  hostWatchParallelBus(CS, DC, dataPins, nullptr);
+
+  begin();
+  lcd.init();
+  report("SSD1353T", "init", 1);
+
+  benchDrawing(lcd, "SSD1353T");
+  benchColor65k(lcd, "SSD1353T");
+  hostUnwatchBuses();
+}
+
+static void benchSSD1353Group() {
+  static SSD1353Group group;
+  static SSD1353Panel left, right;
+  hostWatchParallelBus(CS, DC, dataPins, nullptr);
+  hostWatchParallelBus(CS2, DC, dataPins, nullptr);
+
+  group.init(DC, RS, D0, D1, D2, D3, D4, D5, D6, D7);
+  group.addPanel(left, CS, DISF);
+  group.addPanel(right, CS2, DISF2);
+
+  // Bus bytes count what each panel latched, time what the bus spent
+  begin();
+  group.begin();
+  report("Group", "begin 2 panels broadcast", 1);
+
+  begin(group, left, right);
+  left.init();
+  right.init();
+  report("Group", "init 2 panels alone", 1);
+
+  begin(group, left, right);
+  left.clear();
+  right.clear();
+  report("Group", "clear 2 panels alone", 1);
+
+  begin(group, left, right);
+  group.clear();
+  report("Group", "clear 2 panels broadcast", 1);
+
+  begin(group, left, right);
+  group.printstr("SYNC", 0, 60, 0x3F, 0x3F, 0x3F, 0, 0, 0);
+  left.printstr("LEFT", 0, 0, 0x3F, 0, 0, 0, 0, 0);
+  right.printstr("RIGHT", 0, 0, 0, 0x3F, 0, 0, 0, 0);
+  report("Group", "shared and own text", 1);
+  hostUnwatchBuses();
+}
+
+static void benchSSD1353SPI() {
+  static SSD1353SPI lcd;
+  hostWatchSpiBus(CS, DC, nullptr);
+
+  begin();
+  lcd.init(CS, DC, RS, DISF);
+  report("SSD1353SPI", "init", 1);
+
+  benchDrawing(lcd, "SSD1353SPI");
+  benchColor65k(lcd, "SSD1353SPI");
+  hostUnwatchBuses();
+}
+
+/**
+ * @brief Simulated WizFi360 answering every AT command with OK
+ *
+ */
+static const char* wizfiRespond(const char* line) {
+  if (strncmp(line, "AT+CWJAP=", 9) == 0)
+    return "WIFI CONNECTED\r\nWIFI GOT IP\r\n\r\nOK\r\n";
+  return "\r\nOK\r\n";
+}
+
+static void reportSerial(const char* name, HostStream& serial) {
+  double delayMs = hostCounters.delayMicros / 1000.0;
+  double timeMs  = (hostClock() - startClock) / 1000.0;
+
+  if (csv)
+    printf("WizFi360,%s,%u,%u,%u,%.3f,%.3f\n", name, serial.txBytes, serial.rxBytes, hostCounters.pinEdges, delayMs, timeMs);
+  else
+    printf("%-10s %-24s %10u %10u %12u %10.3f %10.3f\n", "WizFi360", name, serial.txBytes, serial.rxBytes, hostCounters.pinEdges, delayMs, timeMs);
+  serial.txBytes = 0;
+  serial.rxBytes = 0;
+}
+
+static void benchWizFi360() {
+  static HostStream serial(wizfiRespond);
+  static WizFi360 wifi;
+
+  if (!csv)
+    printf("\n%-10s %-24s %10s %10s %12s %10s %10s\n", "group", "benchmark", "tx bytes", "rx bytes", "pin edges", "delay ms", "time ms");
+
+  serial.inject("\r\nready\r\n");
+  begin();
+  wifi.init(&serial, WIZFI_RST);
+  reportSerial("init", serial);
+
+  begin();
+  wifi.setMode(WIZFI_MODE_STATION);
+  reportSerial("setMode", serial);
+
+  begin();
+  wifi.connectWifi("benchmark", "password");
+  reportSerial("connectWifi", serial);
+
+  begin();
+  wifi.disconnectWifi();
+  reportSerial("disconnectWifi", serial);
+}
+
+int main(int argc, char** argv) {
+  csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+
+  header();
+  benchSSD1353();
+  benchSSD1353T();
+  benchSSD1353Group();
+  benchSSD1353SPI();
+  benchWizFi360();
+  return 0;
+}
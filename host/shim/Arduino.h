@@ -0,0 +1,118 @@
+/*
+  Arduino.h - Host-side stand-in for the Arduino core
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define A0 14
+
+#define PROGMEM
+#define PSTR(s)               (s)
+#define F(s)                  (s)
+#define pgm_read_byte(addr)   (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)   (*(const uint16_t*)(addr))
+#define memcpy_P(dst, src, n) memcpy((dst), (src), (n))
+#define strlen_P(s)           strlen(s)
+
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef max
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HOST_PINS  64
+#define HOST_PORTS (HOST_PINS / 8)
+
+/**
+ * @brief Simulated 8-bit output port, every write is checked for pin edges
+ *
+ */
+class HostPort {
+  public:
+  uint8_t index;
+  uint8_t value;
+
+  operator uint8_t() const { return value; }
+  HostPort& operator=(uint8_t newValue);
+};
+
+HostPort* hostPortRegister(uint8_t port);
+
+// Pins are laid out eight to a port: pin n is bit n % 8 of port n / 8
+#define digitalPinToPort(pin)    ((uint8_t)((pin) / 8))
+#define digitalPinToBitMask(pin) ((uint8_t)(1 << ((pin) % 8)))
+#define portOutputRegister(port) hostPortRegister(port)
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+// Hold off the simulated interrupt, see hostSetInterrupt()
+void interrupts();
+void noInterrupts();
+
+// Save and restore primitive, SSD1353_IRQ_SAVE()/SSD1353_IRQ_RESTORE() on the host
+uint32_t hostSaveInterrupts();
+void hostRestoreInterrupts(uint32_t state);
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class Print {
+  public:
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  virtual void flush() {}
+
+  size_t print(const char* str);
+  size_t print(char c);
+  size_t print(long value);
+  size_t println(const char* str);
+  size_t println();
+};
+
+class Stream : public Print {
+  public:
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+};
+
+#endif
@@ -0,0 +1,328 @@
+/*
+  HostArduino.cpp - Host-side stand-in for the Arduino core
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HostSim.h"
+#include <Arduino.h>
+
+HostCounters hostCounters;
+
+static HostPort ports[HOST_PORTS];
+static unsigned long clockMicros;
+static unsigned long clockNanos;
+
+struct HostBus {
+  uint8_t pinCS,
+      pinDC;
+  uint8_t pinD[8];
+  bool spi;
+  HostBusHandler handler;
+};
+
+static HostBus buses[HOST_MAX_BUSES];
+static uint8_t busCount;
+
+static void (*interruptHandler)();
+static uint16_t interruptInterval,
+    interruptCountdown;
+static bool interruptsOff,
+    inInterrupt;
+
+/**
+ * @brief A point where the simulated interrupt may fire
+ *
+ */
+static void interruptPoint() {
+  if (!interruptHandler || interruptsOff || inInterrupt || --interruptCountdown)
+    return;
+
+  // Masked in the handler, as on entry to a hardware one
+  interruptCountdown = interruptInterval;
+  inInterrupt        = true;
+  interruptsOff      = true;
+  interruptHandler();
+  inInterrupt   = false;
+  interruptsOff = false;
+}
+
+static uint8_t pinLevel(uint8_t pin) {
+  return (ports[pin / 8].value >> (pin % 8)) & 1;
+}
+
+/**
+ * @brief Count a latched byte and pass it to the bus handler
+ *
+ * @param b Bus index
+ * @param data Latched byte
+ * @param isCommand DC was low
+ * @param nanos Time the byte took on the bus
+ */
+static void latch(uint8_t b, uint8_t data, bool isCommand, unsigned long nanos) {
+  hostCounters.busBytes++;
+  clockNanos += nanos;
+  clockMicros += clockNanos / 1000;
+  clockNanos %= 1000;
+  if (isCommand)
+    hostCounters.busCommands++;
+  if (buses[b].handler)
+    buses[b].handler(b, data, isCommand);
+  interruptPoint();
+}
+
+/**
+ * @brief Latch a byte on every watched bus whose CS pin just went high
+ *
+ * @param risen Bitmask of pins on the port that rose
+ * @param port Port index
+ */
+static void latchBuses(uint8_t port, uint8_t risen) {
+  // Buses latching on the same edge share the bus cycle
+  unsigned long nanos = HOST_BUS_BYTE_NS;
+  for (uint8_t b = 0; b < busCount; b++) {
+    if (buses[b].spi || buses[b].pinCS / 8 != port || !((risen >> (buses[b].pinCS % 8)) & 1))
+      continue;
+
+    uint8_t data = 0;
+    for (uint8_t i = 0; i < 8; i++)
+      data |= pinLevel(buses[b].pinD[i]) << i;
+    latch(b, data, !pinLevel(buses[b].pinDC), nanos);
+    nanos = 0;
+  }
+}
+
+void hostSpiTransfer(uint8_t data, uint32_t clock) {
+  if (clock > HOST_SPI_MAX_CLOCK)
+    clock = HOST_SPI_MAX_CLOCK;
+  unsigned long nanos = 8000000000ULL / clock;
+
+  bool selected = false;
+  for (uint8_t b = 0; b < busCount; b++) {
+    if (!buses[b].spi || pinLevel(buses[b].pinCS))
+      continue;
+    latch(b, data, !pinLevel(buses[b].pinDC), nanos);
+    selected = true;
+  }
+
+  // Nobody listening, the peripheral still spends the time
+  if (!selected) {
+    clockNanos += nanos;
+    clockMicros += clockNanos / 1000;
+    clockNanos %= 1000;
+  }
+}
+
+HostPort& HostPort::operator=(uint8_t newValue) {
+  uint8_t changed = value ^ newValue;
+  value           = newValue;
+  for (uint8_t i = 0; i < 8; i++)
+    hostCounters.pinEdges += (changed >> i) & 1;
+  if (changed & newValue)
+    latchBuses(index, changed & newValue);
+  return *this;
+}
+
+HostPort* hostPortRegister(uint8_t port) {
+  HostPort* reg = &ports[port % HOST_PORTS];
+  reg->index    = port % HOST_PORTS;
+  return reg;
+}
+
+void hostResetCounters() {
+  memset(&hostCounters, 0, sizeof(hostCounters));
+}
+
+unsigned long hostClock() {
+  return clockMicros;
+}
+
+uint8_t hostWatchParallelBus(uint8_t pinCS, uint8_t pinDC, const uint8_t* pinD, HostBusHandler handler) {
+  HostBus& bus = buses[busCount];
+  bus.pinCS    = pinCS;
+  bus.pinDC    = pinDC;
+  memcpy(bus.pinD, pinD, 8);
+  bus.spi     = false;
+  bus.handler = handler;
+  return busCount++;
+}
+
+uint8_t hostWatchSpiBus(uint8_t pinCS, uint8_t pinDC, HostBusHandler handler) {
+  HostBus& bus = buses[busCount];
+  bus.pinCS    = pinCS;
+  bus.pinDC    = pinDC;
+  bus.spi      = true;
+  bus.handler  = handler;
+  return busCount++;
+}
+
+void hostUnwatchBuses() {
+  busCount = 0;
+}
+
+void hostSetInterrupt(void (*handler)(), uint16_t interval) {
+  interruptHandler   = handler;
+  interruptInterval  = interval ? interval : 1;
+  interruptCountdown = interruptInterval;
+}
+
+void interrupts() {
+  interruptsOff = false;
+  interruptPoint();
+}
+
+void noInterrupts() {
+  interruptsOff = true;
+}
+
+uint32_t hostSaveInterrupts() {
+  bool off      = interruptsOff;
+  interruptsOff = true;
+  return off;
+}
+
+void hostRestoreInterrupts(uint32_t state) {
+  if (state)
+    noInterrupts();
+  else
+    interrupts();
+}
+
+bool hostInterruptsEnabled() {
+  return !interruptsOff;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  HostPort* port = hostPortRegister(pin / 8);
+  uint8_t mask   = 1 << (pin % 8);
+  *port          = value ? (port->value | mask) : (port->value & ~mask);
+}
+
+int digitalRead(uint8_t pin) {
+  return pinLevel(pin);
+}
+
+int analogRead(uint8_t pin) {
+  return pin;
+}
+
+void delay(unsigned long ms) {
+  clockMicros += ms * 1000;
+  hostCounters.delayMicros += ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  clockMicros += us;
+  hostCounters.delayMicros += us;
+}
+
+// Reading the clock costs a microsecond so polling loops always make progress
+unsigned long millis() {
+  interruptPoint();
+  return ++clockMicros / 1000;
+}
+
+unsigned long micros() {
+  interruptPoint();
+  return ++clockMicros;
+}
+
+long random(long max) {
+  return max > 0 ? rand() % max : 0;
+}
+
+long random(long min, long max) {
+  return min < max ? min + rand() % (max - min) : min;
+}
+
+void randomSeed(unsigned long seed) {
+  srand(seed);
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  for (size_t i = 0; i < size; i++)
+    write(buffer[i]);
+  return size;
+}
+
+size_t Print::print(const char* str) {
+  return write((const uint8_t*)str, strlen(str));
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(long value) {
+  char buff[24];
+  snprintf(buff, sizeof(buff), "%ld", value);
+  return print(buff);
+}
+
+size_t Print::println(const char* str) {
+  return print(str) + println();
+}
+
+size_t Print::println() {
+  return print("\r\n");
+}
+
+HostStream::HostStream(Responder responder)
+    : txBytes(0), rxBytes(0), _responder(responder), _lineLength(0), _rxHead(0), _rxTail(0) {}
+
+/**
+ * @brief Queue bytes as if the device had sent them
+ *
+ * @param data Null-terminated bytes to receive
+ */
+void HostStream::inject(const char* data) {
+  while (*data) {
+    _rx[_rxHead] = *data++;
+    _rxHead      = (_rxHead + 1) % sizeof(_rx);
+  }
+}
+
+size_t HostStream::write(uint8_t c) {
+  txBytes++;
+  if (_lineLength < sizeof(_line) - 1)
+    _line[_lineLength++] = c;
+  if (c == '\n') {
+    _line[_lineLength] = '\0';
+    _lineLength        = 0;
+    const char* response = _responder ? _responder(_line) : nullptr;
+    if (response)
+      inject(response);
+  }
+  return 1;
+}
+
+int HostStream::available() {
+  return (_rxHead + sizeof(_rx) - _rxTail) % sizeof(_rx);
+}
+
+int HostStream::read() {
+  if (!available())
+    return -1;
+  rxBytes++;
+  char c  = _rx[_rxTail];
+  _rxTail = (_rxTail + 1) % sizeof(_rx);
+  return (uint8_t)c;
+}
+
+int HostStream::peek() {
+  return available() ? (uint8_t)_rx[_rxTail] : -1;
+}
@@ -0,0 +1,30 @@
+/*
+  HostSPI.cpp - Host-side stand-in for the Arduino SPI library
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HostSim.h"
+#include <SPI.h>
+
+SPIClass SPI;
+
+void SPIClass::beginTransaction(SPISettings settings) {
+  _settings = settings;
+}
+
+void SPIClass::endTransaction() {}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+  hostSpiTransfer(data, _settings.clock);
+  return 0;
+}
@@ -0,0 +1,124 @@
+/*
+  HostSim.h - Counters and simulated peripherals for the host shim
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HOSTSIM_H
+#define HOSTSIM_H
+
+#include <Arduino.h>
+
+#define HOST_MAX_BUSES 4
+
+// Simulated time taken by one byte on a watched bus
+#ifndef HOST_BUS_BYTE_NS
+#define HOST_BUS_BYTE_NS 500
+#endif
+
+// Fastest SPI clock of the simulated MCU, an AVR at 16 MHz divides by two
+#ifndef HOST_SPI_MAX_CLOCK
+#define HOST_SPI_MAX_CLOCK 8000000
+#endif
+
+struct HostCounters {
+  uint32_t pinEdges;    // Output level changes on any pin
+  uint32_t busBytes;    // Bytes latched on watched buses
+  uint32_t busCommands; // Latched bytes with DC low
+  uint32_t delayMicros; // Time spent in delay() and delayMicroseconds()
+};
+
+extern HostCounters hostCounters;
+
+typedef void (*HostBusHandler)(uint8_t bus, uint8_t data, bool isCommand);
+
+void hostResetCounters();
+unsigned long hostClock();
+
+/**
+ * @brief Watch an 8080-style parallel bus, a byte is latched on each rising CS edge
+ *
+ * @param pinCS Chip select pin
+ * @param pinDC Data/command pin
+ * @param pinD Data pins D0-D7
+ * @param handler Called for every latched byte, may be nullptr
+ * @return Bus index passed to the handler
+ */
+uint8_t hostWatchParallelBus(uint8_t pinCS, uint8_t pinDC, const uint8_t* pinD, HostBusHandler handler);
+
+/**
+ * @brief Watch a 4-wire SPI bus, a byte is latched on each transfer while CS is low
+ *
+ * @param pinCS Chip select pin
+ * @param pinDC Data/command pin
+ * @param handler Called for every latched byte, may be nullptr
+ * @return Bus index passed to the handler
+ */
+uint8_t hostWatchSpiBus(uint8_t pinCS, uint8_t pinDC, HostBusHandler handler);
+void hostUnwatchBuses();
+
+/**
+ * @brief Run a handler as if from a timer interrupt
+ *
+ * While interrupts are enabled, every latched bus byte, clock read and
+ * interrupts() call is a point where it may fire; it fires on every
+ * interval-th one. The handler runs with interrupts masked.
+ *
+ * @param handler Interrupt handler, nullptr to stop
+ * @param interval Points between two runs of the handler
+ */
+void hostSetInterrupt(void (*handler)(), uint16_t interval);
+
+/**
+ * @brief Whether the simulated interrupt may fire, it is masked in its own handler
+ *
+ * @return true unless noInterrupts() or a handler holds it off
+ */
+bool hostInterruptsEnabled();
+
+/**
+ * @brief Shift one byte out of the simulated SPI peripheral
+ *
+ * @param data Byte sent
+ * @param clock SPI clock of the transaction in Hz
+ */
+void hostSpiTransfer(uint8_t data, uint32_t clock);
+
+/**
+ * @brief Serial port with a scripted device on the other end
+ *
+ */
+class HostStream : public Stream {
+  public:
+  typedef const char* (*Responder)(const char* line);
+
+  HostStream(Responder responder);
+
+  void inject(const char* data);
+  size_t write(uint8_t c);
+  int available();
+  int read();
+  int peek();
+
+  uint32_t txBytes;
+  uint32_t rxBytes;
+
+  private:
+  Responder _responder;
+  char _line[256];
+  uint16_t _lineLength;
+  char _rx[1024];
+  uint16_t _rxHead,
+      _rxTail;
+};
+
+#endif
@@ -0,0 +1,59 @@
+/*
+  SPI.h - Host-side stand-in for the Arduino SPI library
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+  public:
+  SPISettings()
+      : clock(4000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {}
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+      : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+
+  uint32_t clock;
+  uint8_t bitOrder;
+  uint8_t dataMode;
+};
+
+/**
+ * @brief Simulated SPI peripheral, transferred bytes are latched on watched SPI buses
+ *
+ */
+class SPIClass {
+  public:
+  void begin() {}
+  void end() {}
+  void beginTransaction(SPISettings settings);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+
+  private:
+  SPISettings _settings;
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,95 @@
+/*
+  AsyncTest.cpp - The transfer queue sent from a simulated interrupt draws what direct writes do
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HostSim.h"
+#include "PanelModel.h"
+#include "SSD1353Queue.h"
+#include "Test.h"
+
+#define SESSIONS 200
+#define FRAMES   3
+
+static uint16_t completions;
+static uint16_t pollBudget;
+static uint32_t unmasked; // Handler runs that poll() left with interrupts enabled
+
+static void onComplete() {
+  completions++;
+}
+
+static void timerInterrupt() {
+  testDisplay().poll(pollBudget);
+  if (hostInterruptsEnabled())
+    unmasked++;
+}
+
+// Frames drawn into the queue while a timer interrupt sends it, with
+// queues from the smallest allowed up, must leave the panel as the
+// canvas. onComplete must run once per beginWrite()/endWrite() frame,
+// never while one is being drawn. The queue locks must leave interrupts
+// as they found them, masked in the handler and enabled outside it.
+void testAsync() {
+  static uint8_t buffer[1024];
+  SSD1353& display      = testDisplay();
+  SSD1353Canvas& canvas = testCanvas();
+  uint8_t x, y;
+
+  testSeed(0xA5F1C000);
+  unmasked = 0;
+  for (uint16_t n = 0; n < SESSIONS; n++) {
+    uint16_t size = SSD1353_QUEUE_MIN + testRandom(sizeof(buffer) - SSD1353_QUEUE_MIN + 1);
+    pollBudget    = 1 + testRandom(64);
+    completions   = 0;
+
+    canvas.clear();
+    display.clear();
+    SSD1353Queue queue(buffer, size);
+    if (!CHECK(display.beginAsync(queue, onComplete), "session %u: a %u byte queue is refused", n, size))
+      return;
+    hostSetInterrupt(timerInterrupt, 1 + testRandom(40));
+
+    uint16_t frames = 0;
+    bool counted    = true;
+    for (uint8_t frame = 0; frame < FRAMES && counted; frame++) {
+      uint32_t seed = testRandom(0xFFFFFFFF);
+      testSeed(seed);
+      testScene(canvas);
+      testSeed(seed);
+      display.beginWrite();
+      testScene(display);
+      bool early = completions != frames;
+      display.endWrite();
+      frames++;
+
+      // Main loop polling too, until the frame is out
+      while (display.poll())
+        ;
+      counted = CHECK(!early && completions == frames, "session %u frame %u: onComplete ran %u times for %u frames%s", n, frame,
+                      completions, frames, early ? ", some while drawing" : "");
+    }
+    bool enabled = hostInterruptsEnabled();
+    bool masked  = CHECK(enabled && unmasked == 0, "session %u: interrupts left %s", n, enabled ? "enabled in the handler" : "masked");
+
+    // The queue goes out of scope, detach it before leaving
+    hostSetInterrupt(nullptr, 0);
+    display.endAsync();
+    display.waitIdle();
+    bool same = panelMatches(canvas, x, y);
+    if (!counted || !masked || !CHECK(same, "session %u (queue %u, budget %u): display differs at %u,%u", n, size, pollBudget, x, y))
+      return;
+  }
+
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
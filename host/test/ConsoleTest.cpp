@@ -0,0 +1,73 @@
+/*
+  ConsoleTest.cpp - SSD1353Console shows the last lines written after scrolling
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "SSD1353Console.h"
+#include "Test.h"
+
+#define CONSOLES  100
+#define MAX_LINES 40
+
+// Display around the console
+static const Color565 background(0xF81F);
+
+// Consoles of random size and place get random lines, each one shorter
+// than a row. The region must then show the last lines, bottom row last,
+// and no scroll may copy onto its own source.
+void testConsole() {
+  static char lines[MAX_LINES][SSD1353_WIDTH / 6 + 1];
+  SSD1353& display      = testDisplay();
+  SSD1353Canvas& canvas = testCanvas();
+  uint8_t x, y;
+
+  testSeed(0xC0750000);
+  for (uint16_t n = 0; n < CONSOLES; n++) {
+    uint8_t columns = 1 + testRandom(SSD1353_WIDTH / 6);
+    uint8_t rows    = 1 + testRandom(SSD1353_HEIGHT / 8);
+    uint8_t left    = testRandom(SSD1353_WIDTH - columns * 6 + 1);
+    uint8_t bottom  = testRandom(SSD1353_HEIGHT - rows * 8 + 1);
+    uint8_t count   = 1 + testRandom(MAX_LINES);
+    Color565 text = testColor(4), back = testColor(4);
+
+    for (uint8_t i = 0; i < count; i++) {
+      uint8_t length = testRandom(columns + 1);
+      for (uint8_t c = 0; c < length; c++)
+        lines[i][c] = 'A' + testRandom(26);
+      lines[i][length] = '\0';
+    }
+
+    display.fill(background);
+    panel.overlappingCopies = 0;
+    SSD1353Console console(display, left, bottom, columns, rows);
+    console.setColors(text.red(), text.green(), text.blue(), back.red(), back.green(), back.blue());
+    console.clear();
+    for (uint8_t i = 0; i < count; i++)
+      console.println(lines[i]);
+    display.waitIdle();
+
+    canvas.fill(background);
+    canvas.drawRectangle(left, bottom, left + columns * 6 - 1, bottom + rows * 8 - 1, back, back, true);
+    uint8_t first = count > rows ? count - rows : 0;
+    for (uint8_t i = first; i < count; i++)
+      canvas.printstr(lines[i], left, bottom + (rows - 1 - (i - first)) * 8, text, back);
+
+    bool same = panelMatches(canvas, x, y);
+    if (!CHECK(same, "console %u (%ux%u at %u,%u, %u lines): differs at %u,%u", n, columns, rows, left, bottom, count, x, y) ||
+        !CHECK(panel.overlappingCopies == 0, "console %u: %lu overlapping copies", n, (unsigned long)panel.overlappingCopies))
+      return;
+  }
+
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
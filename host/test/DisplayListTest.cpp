@@ -0,0 +1,159 @@
+/*
+  DisplayListTest.cpp - SSD1353DisplayList replays, optimized or not, draw the same frame
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "SSD1353DisplayList.h"
+#include "Test.h"
+
+#define SCENES      400
+#define LIST_BUFFER 4096
+
+// Coordinate near an earlier one half of the time, so calls touch and merge
+static uint8_t coordinate(uint8_t limit, uint8_t near) {
+  if (!testRandom(2))
+    return testRandom(limit);
+  int16_t value = near + (int16_t)testRandom(9) - 4;
+  return value < 0 ? 0 : value >= limit ? limit - 1 : value;
+}
+
+// Runs of calls the optimizer merges: stacked lines, dotted rows and bars
+// of one color, with an occasional gap or different color among them
+static void recordRun(SSD1353Gfx& list, uint8_t x, uint8_t y) {
+  uint8_t count = 2 + testRandom(12);
+  uint8_t size  = 1 + testRandom(20);
+  uint8_t kind  = testRandom(4);
+  Color565 color = testColor(3);
+
+  for (uint8_t n = 0; n < count; n++) {
+    Color565 c = testRandom(8) ? color : testColor(3);
+    uint8_t step = testRandom(6) ? n : n + 1; // Gap of one now and then
+    uint8_t x0 = min(x + step, SSD1353_WIDTH - 1), y0 = min(y + step, SSD1353_HEIGHT - 1);
+    uint8_t x1 = min(x + size, SSD1353_WIDTH - 1), y1 = min(y + size, SSD1353_HEIGHT - 1);
+
+    switch (kind) {
+      case 0:
+        list.drawLine(x, y0, x1, y0, c);
+        break;
+      case 1:
+        list.drawDot(x0, y, c);
+        break;
+      case 2:
+        list.drawRectangle(x0, y, x0, y1, c, c, testRandom(2));
+        break;
+      case 3:
+        list.drawRectangle(x0, y, x0 + testRandom(3), y1 - testRandom(3), c, c, true);
+        break;
+    }
+  }
+}
+
+// Draw a random scene, a dashboard of bars, gridlines, dots, boxes and
+// labels from a few colors
+void testScene(SSD1353Gfx& list) {
+  uint8_t calls = 20 + testRandom(100);
+  uint8_t x     = testRandom(SSD1353_WIDTH);
+  uint8_t y     = testRandom(SSD1353_HEIGHT);
+
+  for (uint8_t n = 0; n < calls; n++) {
+    uint8_t x0 = coordinate(SSD1353_WIDTH, x), y0 = coordinate(SSD1353_HEIGHT, y);
+    uint8_t x1 = coordinate(SSD1353_WIDTH, x0), y1 = coordinate(SSD1353_HEIGHT, y0);
+    Color565 line = testColor(3), fill = testRandom(4) ? line : testColor(3);
+    x = x0;
+    y = y0;
+
+    switch (testRandom(10)) {
+      case 0:
+        list.drawLine(x0, y0, x1, y0, line);
+        break;
+      case 1:
+        list.drawLine(x0, y0, x0, y1, line);
+        break;
+      case 2:
+        list.drawDot(x0, y0, line);
+        break;
+      case 3:
+        list.drawLine(x0, y0, x1, y1, line);
+        break;
+      case 4:
+        list.drawRectangle(x0, y0, x1, y1, line, fill, false);
+        break;
+      case 5:
+      case 6:
+        list.drawRectangle(x0, y0, x1, y1, line, fill, true);
+        break;
+      case 7:
+      case 8:
+        recordRun(list, x0, y0);
+        break;
+      case 9:
+        if (testRandom(8))
+          list.printchar(x0, y0, 'A' + testRandom(26), line);
+        else
+          list.fill(line);
+        break;
+    }
+  }
+}
+
+void testDisplayList() {
+  static uint8_t plainBuffer[LIST_BUFFER], optimizedBuffer[LIST_BUFFER];
+  static uint16_t stripPixels[SSD1353_WIDTH * 8];
+  SSD1353& display       = testDisplay();
+  SSD1353Canvas& canvas  = testCanvas();
+  SSD1353Canvas strip(stripPixels, SSD1353_WIDTH, 8);
+  SSD1353DisplayList plain(plainBuffer, sizeof(plainBuffer));
+  SSD1353DisplayList optimized(optimizedBuffer, sizeof(optimizedBuffer));
+  uint8_t x, y;
+
+  for (uint16_t scene = 0; scene < SCENES; scene++) {
+    uint32_t seed = 0xD15C0000 + scene;
+    plain.reset();
+    optimized.reset();
+    testSeed(seed);
+    testScene(plain);
+    testSeed(seed);
+    testScene(optimized);
+    optimized.optimize();
+    if (!CHECK(!plain.overflowed() && optimized.length() <= plain.length(), "scene %u: list overflowed or grew", scene))
+      return;
+
+    // The unoptimized list on the panel is the reference
+    canvas.clear();
+    plain.replay(canvas);
+    display.clear();
+    plain.replay(display);
+    display.waitIdle();
+    bool same = panelMatches(canvas, x, y);
+    if (!CHECK(same, "scene %u: unoptimized replay differs from the canvas at %u,%u", scene, x, y))
+      return;
+
+    display.clear();
+    optimized.replay(display);
+    display.waitIdle();
+    same = panelMatches(canvas, x, y);
+    if (!CHECK(same, "scene %u: optimized replay differs at %u,%u", scene, x, y))
+      return;
+
+    // Banded rendering through a strip canvas, on a black background
+    display.fill(Color565(0xF81F));
+    optimized.renderBands(display, strip);
+    display.waitIdle();
+    same = panelMatches(canvas, x, y);
+    if (!CHECK(same, "scene %u: banded replay differs at %u,%u", scene, x, y))
+      return;
+  }
+
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
@@ -0,0 +1,124 @@
+/*
+  FrameDiffTest.cpp - SSD1353FrameDiff leaves the display showing the next frame
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "SSD1353FrameDiff.h"
+#include "Test.h"
+
+#define FRAMES 300
+
+// Display around canvases smaller than it
+static const Color565 background(0xF81F);
+
+static uint8_t randomBetween(uint8_t from, uint8_t to) {
+  return from + testRandom(to - from + 1);
+}
+
+// Random edit of the frame: a block or a line of one color, scattered
+// pixels, a gradient no run of one color fits, or a character
+static void edit(SSD1353Canvas& frame) {
+  uint8_t x0 = randomBetween(frame.originX(), frame.originX() + frame.width() - 1);
+  uint8_t y0 = randomBetween(frame.originY(), frame.originY() + frame.height() - 1);
+  // min() is a macro, the random sizes are drawn before it
+  int16_t w  = testRandom(testRandom(4) ? 12 : frame.width());
+  int16_t h  = testRandom(testRandom(4) ? 12 : frame.height());
+  uint8_t x1 = min(x0 + w, frame.originX() + frame.width() - 1);
+  uint8_t y1 = min(y0 + h, frame.originY() + frame.height() - 1);
+
+  switch (testRandom(6)) {
+    case 0:
+      frame.fillRect(x0, y0, x1, y1, testColor(4).value);
+      break;
+    case 1:
+      frame.fillRect(x0, y0, testRandom(2) ? x1 : x0, testRandom(2) ? y0 : y1, testColor(4).value);
+      break;
+    case 2:
+      for (uint8_t n = testRandom(40); n > 0; n--)
+        frame.setPixel(randomBetween(x0, x1), randomBetween(y0, y1), testColor().value);
+      break;
+    case 3:
+      for (uint8_t y = y0; y <= y1; y++)
+        for (uint8_t x = x0; x <= x1; x++)
+          frame.setPixel(x, y, (uint16_t)(x * 37 + y * 91));
+      break;
+    case 4:
+      frame.drawRectangle(x0, y0, x1, y1, testColor(4), testColor(4), testRandom(2));
+      break;
+    case 5:
+      frame.printchar(x0, y0, 'A' + testRandom(26), testColor(4));
+      break;
+  }
+}
+
+// Canvas pixels inside it, the background around it
+static bool panelShows(const SSD1353Canvas& frame, uint8_t& x, uint8_t& y) {
+  for (y = 0; y < SSD1353_HEIGHT; y++)
+    for (x = 0; x < SSD1353_WIDTH; x++) {
+      bool inside    = x >= frame.originX() && x < frame.originX() + frame.width() && y >= frame.originY() && y < frame.originY() + frame.height();
+      uint16_t color = inside ? frame.getPixel(x, y) : background.value;
+      if (panel.pixel(x, y) != PanelModel::from565(color))
+        return false;
+    }
+  return true;
+}
+
+// Random frame pairs in both color depths, on whole display canvases, on
+// smaller ones placed anywhere and on ones wider than the display, cut at
+// its edge. After update() the panel must show the next frame exactly.
+void testFrameDiff() {
+  static SSD1353Framebuffer full;
+  static uint16_t smallBuffers[2][0xFF * 16];
+  SSD1353& display = testDisplay();
+  SSD1353FrameDiff diff(display);
+  uint8_t x, y;
+
+  testSeed(0xF4A3D1FF);
+  for (uint16_t n = 0; n < FRAMES; n++) {
+    bool small   = testRandom(3) == 0;
+    bool wide    = small && testRandom(4) == 0;
+    uint8_t w    = wide ? randomBetween(SSD1353_WIDTH + 1, 0xFF) : randomBetween(1, 64);
+    uint8_t h    = wide ? randomBetween(1, 16) : randomBetween(1, 48);
+    uint8_t ox   = wide ? 0 : testRandom(SSD1353_WIDTH - w + 1), oy = testRandom(SSD1353_HEIGHT - h + 1);
+    SSD1353Canvas smallPrevious(smallBuffers[0], w, h, ox, oy);
+    SSD1353Canvas smallNext(smallBuffers[1], w, h, ox, oy);
+    SSD1353Canvas& previous = small ? smallPrevious : testCanvas();
+    SSD1353Canvas& next     = small ? smallNext : full;
+    uint8_t depth           = testRandom(2) ? SSD1353_COLOR_65K : SSD1353_COLOR_262K;
+
+    previous.fill(testColor(4));
+    for (uint8_t e = testRandom(20); e > 0; e--)
+      edit(previous);
+    memcpy(next.buffer(), previous.buffer(), sizeof(uint16_t) * next.width() * next.height());
+    uint8_t edits = testRandom(10);
+    for (uint8_t e = edits; e > 0; e--)
+      edit(next);
+
+    display.setColorDepth(depth);
+    display.fill(background);
+    previous.flush(display);
+    uint32_t bytes = diff.update(previous, next);
+    display.waitIdle();
+
+    bool same = panelShows(next, x, y);
+    if (!CHECK(same, "frame %u (%s, %ux%u at %u,%u, %u edits): differs at %u,%u", n,
+               depth == SSD1353_COLOR_65K ? "65k" : "262k", next.width(), next.height(), next.originX(), next.originY(), edits, x, y))
+      break;
+    if (!CHECK(edits || bytes == 0, "frame %u: %lu bytes sent for an unchanged frame", n, (unsigned long)bytes))
+      break;
+  }
+
+  display.setColorDepth(SSD1353_COLOR_262K);
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
@@ -0,0 +1,203 @@
+/*
+  ImageTest.cpp - Run-length encoded images decode to the pixels they were made from
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "SSD1353Image.h"
+#include "Test.h"
+
+#define IMAGES     400
+#define MAX_SIDE   80
+#define MAX_PACKET 128
+
+// Display around the image
+static const Color565 background(0xF81F);
+
+// Stream over a block of memory, ends where the block does
+class MemoryStream : public Stream {
+  public:
+  MemoryStream(const uint8_t* data, uint16_t length)
+      : _data(data), _length(length), _position(0) {}
+
+  size_t write(uint8_t) { return 0; }
+  int available() { return _length - _position; }
+  int read() { return _position < _length ? _data[_position++] : -1; }
+  int peek() { return _position < _length ? _data[_position] : -1; }
+
+  private:
+  const uint8_t* _data;
+  uint16_t _length,
+      _position;
+};
+
+// Image pixels as values, palette indices or RGB565 colors, bottom row first
+static uint16_t values[MAX_SIDE * MAX_SIDE];
+static uint8_t encoded[SSD1353_IMAGE_HEADER + 2 * 255 + MAX_SIDE * MAX_SIDE * 3];
+
+// Same packets as png2rle.py: runs where they save bytes, literals between
+static uint16_t encode(uint8_t width, uint8_t height, const uint16_t* palette, uint8_t paletteSize) {
+  uint8_t valueBytes = paletteSize ? 1 : 2;
+  uint8_t minRun     = paletteSize ? 3 : 2;
+  uint16_t count     = (uint16_t)width * height;
+  uint16_t out       = 0;
+
+  encoded[out++] = width;
+  encoded[out++] = height;
+  encoded[out++] = paletteSize;
+  for (uint8_t i = 0; i < paletteSize; i++) {
+    encoded[out++] = palette[i] & 0xFF;
+    encoded[out++] = palette[i] >> 8;
+  }
+
+  uint16_t literal = 0, literalLength = 0;
+  for (uint16_t i = 0; i <= count;) {
+    uint16_t n = 1;
+    while (i < count && i + n < count && values[i + n] == values[i] && n < MAX_PACKET)
+      n++;
+    bool isRun = i < count && n >= minRun;
+
+    // Literals end at a run, at the end and when a packet is full
+    if (isRun || i == count || literalLength + n > MAX_PACKET) {
+      if (literalLength) {
+        encoded[out++] = literalLength - 1;
+        for (uint16_t k = literal; k < literal + literalLength; k++) {
+          encoded[out++] = values[k] & 0xFF;
+          if (valueBytes == 2)
+            encoded[out++] = values[k] >> 8;
+        }
+      }
+      literal       = i;
+      literalLength = 0;
+    }
+    if (i == count)
+      break;
+
+    if (isRun) {
+      encoded[out++] = SSD1353_IMAGE_RUN | (n - 1);
+      encoded[out++] = values[i] & 0xFF;
+      if (valueBytes == 2)
+        encoded[out++] = values[i] >> 8;
+      literal = i + n;
+    } else
+      literalLength += n;
+    i += n;
+  }
+  return out;
+}
+
+// Random image of flat areas, stripes and noise, in the first colors of
+// the palette or in any RGB565 color. Some are mostly flat, so runs reach
+// past the longest packet.
+static void paint(uint8_t width, uint8_t height, uint32_t colors) {
+  uint16_t count = (uint16_t)width * height;
+  uint16_t value = testRandom(colors);
+  uint16_t calm  = testRandom(4) ? 8 : 1000;
+
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t change = testRandom(calm);
+    if (change == 0)
+      value = testRandom(colors);
+    else if (change == 1)
+      value = (i * 7) % colors;
+    values[i] = value;
+  }
+}
+
+// Images with and without a palette, from program memory and from a
+// stream, in both color depths, partly off the display and clipped. The
+// panel must show each image pixel where it is visible and nothing else.
+void testImages() {
+  SSD1353& display = testDisplay();
+  uint16_t palette[255];
+  uint8_t x, y;
+
+  testSeed(0x1AA6E000);
+  for (uint16_t n = 0; n < IMAGES; n++) {
+    uint8_t width       = 1 + testRandom(MAX_SIDE);
+    uint8_t height      = 1 + testRandom(MAX_SIDE);
+    bool fromStream     = testRandom(2);
+    uint8_t paletteSize = testRandom(3) ? 0 : 1 + testRandom(fromStream ? SSD1353_IMAGE_STREAM_PALETTE : 255);
+    uint8_t left        = testRandom(4) ? testRandom(SSD1353_WIDTH) : testRandom(256);
+    uint8_t bottom      = testRandom(4) ? testRandom(SSD1353_HEIGHT) : testRandom(256);
+    uint8_t depth       = testRandom(2) ? SSD1353_COLOR_65K : SSD1353_COLOR_262K;
+    SSD1353Rect clip    = {0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1};
+    if (testRandom(2)) {
+      clip.x0 = testRandom(SSD1353_WIDTH);
+      clip.x1 = clip.x0 + testRandom(SSD1353_WIDTH - clip.x0);
+      clip.y0 = testRandom(SSD1353_HEIGHT);
+      clip.y1 = clip.y0 + testRandom(SSD1353_HEIGHT - clip.y0);
+    }
+
+    // Program memory images may use indices past their palette, drawn black
+    for (uint8_t i = 0; i < paletteSize; i++)
+      palette[i] = testColor().value;
+    paint(width, height, paletteSize ? paletteSize + (fromStream ? 0 : testRandom(2)) : 0x10000);
+    uint16_t length = encode(width, height, palette, paletteSize);
+
+    display.setColorDepth(depth);
+    display.fill(background);
+    display.pushClip(clip.x0, clip.y0, clip.x1, clip.y1);
+    MemoryStream stream(encoded, length);
+    bool drawn = fromStream ? display.drawImage(left, bottom, stream) : display.drawImage(left, bottom, encoded);
+    display.popClip();
+    display.waitIdle();
+
+    bool same = true;
+    for (y = 0; y < SSD1353_HEIGHT && same; y++)
+      for (x = 0; x < SSD1353_WIDTH && same; x++) {
+        uint16_t color = background.value;
+        if (x >= left && x - left < width && y >= bottom && y - bottom < height && x >= clip.x0 && x <= clip.x1 && y >= clip.y0 && y <= clip.y1) {
+          uint16_t value = values[(y - bottom) * width + (x - left)];
+          color          = !paletteSize ? value : value < paletteSize ? palette[value] : 0;
+        }
+        same = panel.pixel(x, y) == PanelModel::from565(color);
+      }
+
+    const char* source = fromStream ? "stream" : "program memory";
+    if (!CHECK(drawn, "image %u from %s: not decoded", n, source) ||
+        !CHECK(same, "image %u from %s (%ux%u at %u,%u, palette %u): differs at %u,%u", n, source, width, height, left, bottom, paletteSize, x - 1, y - 1) ||
+        !CHECK(!fromStream || !stream.available(), "image %u: %d stream bytes left", n, stream.available()))
+      break;
+  }
+
+  // Streams that end early or have too large a palette are reported, and
+  // a stream is read to the end of the image even when none of it shows
+  for (uint16_t n = 0; n < IMAGES / 4; n++) {
+    uint8_t width       = 1 + testRandom(MAX_SIDE);
+    uint8_t height      = 1 + testRandom(MAX_SIDE);
+    uint8_t paletteSize = testRandom(2) ? 0 : 1 + testRandom(SSD1353_IMAGE_STREAM_PALETTE);
+    for (uint8_t i = 0; i < paletteSize; i++)
+      palette[i] = testColor().value;
+    paint(width, height, paletteSize ? paletteSize : 0x10000);
+    uint16_t length = encode(width, height, palette, paletteSize);
+
+    MemoryStream cut(encoded, testRandom(length));
+    if (!CHECK(!display.drawImage(testRandom(SSD1353_WIDTH), testRandom(SSD1353_HEIGHT), cut), "image %u: stream cut short is drawn", n))
+      break;
+
+    MemoryStream hidden(encoded, length);
+    if (!CHECK(display.drawImage(SSD1353_WIDTH, SSD1353_HEIGHT, hidden) && !hidden.available(), "image %u: off-screen stream image not read to its end", n))
+      break;
+  }
+
+  memset(encoded, 0, sizeof(encoded));
+  encoded[0] = 1;
+  encoded[1] = 1;
+  encoded[2] = SSD1353_IMAGE_STREAM_PALETTE + 1;
+  MemoryStream large(encoded, SSD1353_IMAGE_HEADER + 2 * (SSD1353_IMAGE_STREAM_PALETTE + 1) + 2);
+  CHECK(!display.drawImage(0, 0, large), "stream image with a %u color palette is drawn", SSD1353_IMAGE_STREAM_PALETTE + 1);
+
+  display.setColorDepth(SSD1353_COLOR_262K);
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
@@ -0,0 +1,254 @@
+/*
+  PanelModel.cpp - SSD1353 display RAM rebuilt from the bus traffic, for the host tests
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "HostSim.h"
+
+// Same wiring as the benchmark
+#define CS   2
+#define DC   3
+#define RS   4
+#define DISF 5
+#define D0   6
+#define D1   7
+#define D2   8
+#define D3   9
+#define D4   10
+#define D5   11
+#define D6   12
+#define D7   13
+
+#define WRITE_RAM 0x5C
+
+PanelModel panel;
+
+// Argument bytes following each command, 0xFF for unknown commands
+static uint8_t argumentCount(uint8_t command) {
+  switch (command) {
+    case 0x15:
+    case 0x75:
+      return 2;
+    case 0x21:
+      return 7;
+    case 0x22:
+      return 10;
+    case 0x23:
+      return 6;
+    case 0x27:
+      return 5;
+    case 0x26:
+    case 0x81:
+    case 0x82:
+    case 0x83:
+    case 0x87:
+    case 0xA0:
+      return 1;
+    case 0xB8:
+      return SSD1353_GAMMA_ENTRIES;
+    case WRITE_RAM:
+    case 0x2E:
+    case 0x2F:
+    case 0xA4:
+    case 0xA6:
+    case 0xA7:
+    case 0xAE:
+    case 0xAF:
+    case 0xB9:
+      return 0;
+  }
+  return 0xFF;
+}
+
+static uint8_t expand5(uint8_t value) {
+  return (value << 1) | (value >> 4);
+}
+
+void PanelModel::reset(uint32_t color) {
+  for (uint8_t y = 0; y < SSD1353_HEIGHT; y++)
+    for (uint8_t x = 0; x < SSD1353_WIDTH; x++)
+      _ram[y][x] = color;
+  unknownCommands   = 0;
+  overlappingCopies = 0;
+  _command          = 0;
+  _argCount         = 0;
+  _argsNeeded       = 0;
+  _writing          = false;
+  _pixelCount       = 0;
+}
+
+void PanelModel::setPixel(int16_t x, int16_t y, uint32_t color) {
+  if (x >= 0 && x < SSD1353_WIDTH && y >= 0 && y < SSD1353_HEIGHT)
+    _ram[y][x] = color;
+}
+
+uint32_t PanelModel::from565(uint16_t color) {
+  return PANEL_RGB(expand5(color >> 11), (color >> 5) & 0x3F, expand5(color & 0x1F));
+}
+
+void PanelModel::latch(uint8_t data, bool isCommand) {
+  if (isCommand) {
+    _command    = data;
+    _argCount   = 0;
+    _argsNeeded = argumentCount(data);
+    _writing    = false;
+    if (_argsNeeded == 0xFF) {
+      unknownCommands++;
+      _argsNeeded = 0;
+    } else if (_argsNeeded == 0)
+      execute();
+    return;
+  }
+
+  if (_argCount < _argsNeeded) {
+    _args[_argCount++] = data;
+    if (_argCount == _argsNeeded)
+      execute();
+    return;
+  }
+  if (!_writing)
+    return;
+
+  _pixelBytes[_pixelCount++] = data;
+  if (_color65k && _pixelCount == 2) {
+    writePixel(PANEL_RGB(expand5(_pixelBytes[1] & 0x1F), (_pixelBytes[0] & 7) << 3 | _pixelBytes[1] >> 5, expand5(_pixelBytes[0] >> 3)));
+    _pixelCount = 0;
+  } else if (!_color65k && _pixelCount == 3) {
+    writePixel(PANEL_RGB(_pixelBytes[2] & 0x3F, _pixelBytes[1] & 0x3F, _pixelBytes[0] & 0x3F));
+    _pixelCount = 0;
+  }
+}
+
+void PanelModel::execute() {
+  const uint8_t* a = _args;
+
+  switch (_command) {
+    case 0x15:
+    case 0x75: {
+      uint8_t* window = &_window[_command == 0x15 ? 0 : 2];
+      window[0]       = a[0];
+      window[1]       = a[1];
+      _writeX         = _window[0];
+      _writeY         = _window[2];
+      break;
+    }
+    case WRITE_RAM:
+      _writing    = true;
+      _pixelCount = 0;
+      _writeX     = _window[0];
+      _writeY     = _window[2];
+      break;
+    case 0xA0:
+      _color65k = (a[0] & 0xC0) == SSD1353_COLOR_65K;
+      break;
+    case 0x26:
+      _fill = a[0] & 1;
+      break;
+    case 0x21:
+      line(a[0], a[1], a[2], a[3], PANEL_RGB(a[6] & 0x3F, a[5] & 0x3F, a[4] & 0x3F));
+      break;
+    case 0x22: {
+      uint8_t x0 = min(a[0], a[2]), x1 = max(a[0], a[2]);
+      uint8_t y0 = min(a[1], a[3]), y1 = max(a[1], a[3]);
+      uint32_t lineColor = PANEL_RGB(a[6] & 0x3F, a[5] & 0x3F, a[4] & 0x3F);
+      uint32_t fillColor = PANEL_RGB(a[9] & 0x3F, a[8] & 0x3F, a[7] & 0x3F);
+      for (int16_t y = y0; y <= y1; y++)
+        for (int16_t x = x0; x <= x1; x++) {
+          bool border = x == x0 || x == x1 || y == y0 || y == y1;
+          if (border)
+            setPixel(x, y, lineColor);
+          else if (_fill)
+            setPixel(x, y, fillColor);
+        }
+      break;
+    }
+    case 0x23: {
+      // The datasheet does not say how overlapping areas are copied, such
+      // copies are counted and done in raster order, as a simple engine would
+      uint8_t x0 = min(a[0], a[2]), x1 = max(a[0], a[2]);
+      uint8_t y0 = min(a[1], a[3]), y1 = max(a[1], a[3]);
+      if (a[4] <= x1 && a[4] + x1 - x0 >= x0 && a[5] <= y1 && a[5] + y1 - y0 >= y0)
+        overlappingCopies++;
+      for (int16_t y = y0; y <= y1 && y < SSD1353_HEIGHT; y++)
+        for (int16_t x = x0; x <= x1 && x < SSD1353_WIDTH; x++)
+          setPixel(a[4] + x - x0, a[5] + y - y0, _ram[y][x]);
+      break;
+    }
+  }
+}
+
+// Window writes run along X, then on to the next row
+void PanelModel::writePixel(uint32_t color) {
+  setPixel(_writeX, _writeY, color);
+  if (_writeX < _window[1])
+    _writeX++;
+  else {
+    _writeX = _window[0];
+    _writeY = _writeY < _window[3] ? _writeY + 1 : _window[2];
+  }
+}
+
+void PanelModel::line(int16_t startX, int16_t startY, int16_t endX, int16_t endY, uint32_t color) {
+  int16_t dx  = abs(endX - startX);
+  int16_t dy  = -abs(endY - startY);
+  int8_t sx   = startX < endX ? 1 : -1;
+  int8_t sy   = startY < endY ? 1 : -1;
+  int16_t err = dx + dy;
+
+  while (true) {
+    setPixel(startX, startY, color);
+    if (startX == endX && startY == endY)
+      break;
+    int16_t e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      startX += sx;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      startY += sy;
+    }
+  }
+}
+
+static void onByte(uint8_t, uint8_t data, bool isCommand) {
+  panel.latch(data, isCommand);
+}
+
+SSD1353& testDisplay() {
+  static SSD1353 display;
+  static bool started = false;
+
+  if (!started) {
+    static const uint8_t dataPins[] = {D0, D1, D2, D3, D4, D5, D6, D7};
+    panel.reset();
+    hostWatchParallelBus(CS, DC, dataPins, onByte);
+    display.init(CS, DC, RS, DISF, D0, D1, D2, D3, D4, D5, D6, D7);
+    started = true;
+  }
+  return display;
+}
+
+SSD1353Canvas& testCanvas() {
+  static SSD1353Framebuffer canvas;
+  return canvas;
+}
+
+bool panelMatches(const SSD1353Canvas& canvas, uint8_t& x, uint8_t& y) {
+  for (y = 0; y < SSD1353_HEIGHT; y++)
+    for (x = 0; x < SSD1353_WIDTH; x++)
+      if (panel.pixel(x, y) != PanelModel::from565(canvas.getPixel(x, y)))
+        return false;
+  return true;
+}
@@ -0,0 +1,85 @@
+/*
+  PanelModel.h - SSD1353 display RAM rebuilt from the bus traffic, for the host tests
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PANELMODEL_H
+#define PANELMODEL_H
+
+#include <Arduino.h>
+
+#include "SSD1353.h"
+#include "SSD1353Canvas.h"
+
+// Pixel as the panel holds it, 6-bit red, green and blue
+#define PANEL_RGB(red, green, blue) ((uint32_t)(red) << 12 | (uint32_t)(green) << 6 | (blue))
+
+/**
+ * @brief Display RAM of one SSD1353, rebuilt from the bytes it latches
+ *
+ * Window writes in both color depths, lines, rectangles with and without
+ * fill and copies are carried out. Lines use the same Bresenham walk as
+ * SSD1353Canvas, from the first point to the second. Copies run in raster
+ * order, so an overlapping one can smear.
+ */
+class PanelModel {
+  public:
+  void reset(uint32_t color = 0);
+  void latch(uint8_t data, bool isCommand);
+
+  uint32_t pixel(uint8_t x, uint8_t y) const { return _ram[y][x]; }
+  void setPixel(int16_t x, int16_t y, uint32_t color);
+  static uint32_t from565(uint16_t color);
+
+  uint32_t unknownCommands;   // Commands the model does not know
+  uint32_t overlappingCopies; // Copies whose source and destination overlap
+
+  private:
+  uint32_t _ram[SSD1353_HEIGHT][SSD1353_WIDTH];
+  uint8_t _command;
+  uint8_t _args[SSD1353_GAMMA_ENTRIES];
+  uint8_t _argCount,
+      _argsNeeded;
+  bool _fill;
+  bool _color65k;
+  bool _writing;
+  uint8_t _window[4]; // Columns then rows
+  uint8_t _writeX,
+      _writeY;
+  uint8_t _pixelBytes[3];
+  uint8_t _pixelCount;
+
+  void execute();
+  void writePixel(uint32_t color);
+  void line(int16_t startX, int16_t startY, int16_t endX, int16_t endY, uint32_t color);
+};
+
+extern PanelModel panel;
+
+// Parallel bus SSD1353 on the host shim, every byte it sends reaches panel
+SSD1353& testDisplay();
+
+// SSD1353Canvas drawn over the whole display, kept alive for all tests
+SSD1353Canvas& testCanvas();
+
+/**
+ * @brief Compare the panel with a canvas covering the whole display
+ *
+ * @param canvas Expected contents
+ * @param x Set to the X coordinate of the first difference
+ * @param y Set to the Y coordinate of the first difference
+ * @return Every pixel matches, true/false
+ */
+bool panelMatches(const SSD1353Canvas& canvas, uint8_t& x, uint8_t& y);
+
+#endif
@@ -0,0 +1,270 @@
+/*
+  ShapesTest.cpp - Shapes on the display and on a canvas against reference geometry
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PanelModel.h"
+#include "Test.h"
+
+#define ROUND_SHAPES 600
+#define TRIANGLES    600
+#define POLYGONS     300
+
+// Background no shape is drawn in
+static const Color565 background(0xF81F);
+
+static SSD1353Framebuffer expected;
+
+// Round shape with its corner centers, as SSD1353Gfx::drawRound takes it
+struct Round {
+  int16_t left,
+      right,
+      top,
+      bottom;
+  uint8_t radiusX,
+      radiusY;
+
+  // x^2 / (rx + 1/2)^2 + y^2 / (ry + 1/2)^2 <= 1 around the nearest corner center
+  bool inside(int16_t x, int16_t y) const {
+    int64_t dx = max(0, max(left - x, x - right));
+    int64_t dy = max(0, max(top - y, y - bottom));
+    int64_t a  = (2 * radiusX + 1) * (2 * radiusX + 1);
+    int64_t b  = (2 * radiusY + 1) * (2 * radiusY + 1);
+    return dy <= radiusY && 4 * dx * dx * b <= (b - 4 * dy * dy) * a;
+  }
+
+  // Inside, next to a pixel that is not
+  bool edge(int16_t x, int16_t y) const {
+    return inside(x, y) && (!inside(x - 1, y) || !inside(x + 1, y) || !inside(x, y - 1) || !inside(x, y + 1));
+  }
+};
+
+static bool sameCanvas(const SSD1353Canvas& a, const SSD1353Canvas& b, uint8_t& x, uint8_t& y) {
+  for (y = 0; y < SSD1353_HEIGHT; y++)
+    for (x = 0; x < SSD1353_WIDTH; x++)
+      if (a.getPixel(x, y) != b.getPixel(x, y))
+        return false;
+  return true;
+}
+
+// Put the background back outside the clip rectangle
+static void maskOutside(SSD1353Canvas& canvas, const SSD1353Rect& clip) {
+  for (uint8_t y = 0; y < SSD1353_HEIGHT; y++)
+    for (uint8_t x = 0; x < SSD1353_WIDTH; x++)
+      if (x < clip.x0 || x > clip.x1 || y < clip.y0 || y > clip.y1)
+        canvas.setPixel(x, y, background.value);
+}
+
+// Clip rectangle for half of the shapes, the whole display for the rest
+static SSD1353Rect randomClip() {
+  SSD1353Rect clip = {0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1};
+  if (testRandom(2)) {
+    clip.x0 = testRandom(SSD1353_WIDTH);
+    clip.x1 = clip.x0 + testRandom(SSD1353_WIDTH - clip.x0);
+    clip.y0 = testRandom(SSD1353_HEIGHT);
+    clip.y1 = clip.y0 + testRandom(SSD1353_HEIGHT - clip.y0);
+  }
+  return clip;
+}
+
+static void begin(SSD1353& display, SSD1353Canvas& canvas, const SSD1353Rect& clip) {
+  canvas.fill(background);
+  display.fill(background);
+  display.pushClip(clip.x0, clip.y0, clip.x1, clip.y1);
+}
+
+static bool end(SSD1353& display, const char* shape, uint16_t n) {
+  uint8_t x, y;
+  display.popClip();
+  display.waitIdle();
+  bool same = panelMatches(expected, x, y);
+  return CHECK(same, "%s %u: display differs at %u,%u", shape, n, x, y);
+}
+
+// Circles, ellipses and rounded rectangles, filled, outlined or both, up
+// to radius 255 so the profile's largest terms are exercised
+static void testRound() {
+  SSD1353& display      = testDisplay();
+  SSD1353Canvas& canvas = testCanvas();
+  static const char* const names[] = {"circle", "ellipse", "round rectangle"};
+  uint8_t x, y;
+
+  testSeed(0x0C1C1E00);
+  for (uint16_t n = 0; n < ROUND_SHAPES; n++) {
+    uint8_t kind  = testRandom(3);
+    bool large    = testRandom(4) == 0;
+    uint8_t rx    = large ? 128 + testRandom(128) : testRandom(60);
+    uint8_t ry    = kind == 1 ? (large ? 128 + testRandom(128) : testRandom(60)) : rx;
+    uint8_t cx    = testRandom(large ? 256 : SSD1353_WIDTH + 20);
+    uint8_t cy    = testRandom(large ? 256 : SSD1353_HEIGHT + 20);
+    bool useFill  = testRandom(3) != 0;
+    Color565 line = testColor(4), fill = testRandom(2) ? line : testColor(4);
+    Round shape   = {cx, cx, cy, cy, rx, ry};
+    SSD1353Rect clip = randomClip();
+
+    begin(display, canvas, clip);
+    if (kind == 0) {
+      canvas.drawCircle(cx, cy, rx, line, fill, useFill);
+      display.drawCircle(cx, cy, rx, line, fill, useFill);
+    } else if (kind == 1) {
+      canvas.drawEllipse(cx, cy, rx, ry, line, fill, useFill);
+      display.drawEllipse(cx, cy, rx, ry, line, fill, useFill);
+    } else {
+      uint8_t x1 = testRandom(SSD1353_WIDTH), y1 = testRandom(SSD1353_HEIGHT);
+      uint8_t x2 = testRandom(SSD1353_WIDTH), y2 = testRandom(SSD1353_HEIGHT);
+      uint8_t radius = testRandom(40);
+      canvas.drawRoundRect(x1, y1, x2, y2, radius, line, fill, useFill);
+      display.drawRoundRect(x1, y1, x2, y2, radius, line, fill, useFill);
+      radius  = min(radius, min(abs(x2 - x1) / 2, abs(y2 - y1) / 2));
+      shape   = {(int16_t)(min(x1, x2) + radius), (int16_t)(max(x1, x2) - radius),
+                 (int16_t)(min(y1, y2) + radius), (int16_t)(max(y1, y2) - radius), radius, radius};
+    }
+
+    // Outline on the edge pixels, fill inside them
+    bool outline = !useFill || line != fill;
+    for (y = 0; y < SSD1353_HEIGHT; y++)
+      for (x = 0; x < SSD1353_WIDTH; x++) {
+        Color565 color = background;
+        if (outline && shape.edge(x, y))
+          color = line;
+        else if (useFill && shape.inside(x, y))
+          color = fill;
+        expected.setPixel(x, y, color.value);
+      }
+
+    bool same = sameCanvas(canvas, expected, x, y);
+    if (!CHECK(same, "%s %u (radius %u,%u at %u,%u): canvas differs at %u,%u", names[kind], n, shape.radiusX, shape.radiusY, cx, cy, x, y))
+      return;
+    maskOutside(expected, clip);
+    if (!end(display, names[kind], n))
+      return;
+  }
+}
+
+// Twice the signed area of a, b, c, positive when counterclockwise
+static int32_t cross(int16_t ax, int16_t ay, int16_t bx, int16_t by, int16_t cx, int16_t cy) {
+  return (int32_t)(bx - ax) * (cy - ay) - (int32_t)(by - ay) * (cx - ax);
+}
+
+// Filled triangles cover every pixel center inside them and nothing more
+// than a pixel outside; outlines end on the corners. The display must draw
+// what the canvas does, filled ones also when clipped.
+static void testTriangles() {
+  SSD1353& display      = testDisplay();
+  SSD1353Canvas& canvas = testCanvas();
+  uint8_t x, y;
+
+  testSeed(0x7A1A0000);
+  for (uint16_t n = 0; n < TRIANGLES; n++) {
+    uint8_t size     = testRandom(4) ? 8 + testRandom(40) : SSD1353_WIDTH;
+    uint8_t ox       = testRandom(SSD1353_WIDTH - min(size, SSD1353_WIDTH - 1));
+    uint8_t oy       = testRandom(SSD1353_HEIGHT - min(size, SSD1353_HEIGHT - 1));
+    SSD1353Point p[] = {{(uint8_t)(ox + testRandom(size)), (uint8_t)(oy + testRandom(size))},
+                        {(uint8_t)(ox + testRandom(size)), (uint8_t)(oy + testRandom(size))},
+                        {(uint8_t)(ox + testRandom(size)), (uint8_t)(oy + testRandom(size))}};
+    for (uint8_t i = 0; i < 3; i++) {
+      p[i].x = min(p[i].x, SSD1353_WIDTH - 1);
+      p[i].y = min(p[i].y, SSD1353_HEIGHT - 1);
+    }
+    bool outlined    = testRandom(2);
+    Color565 fill    = testColor(4);
+    Color565 line    = fill;
+    while (outlined && line == fill)
+      line = testColor(4);
+    SSD1353Rect clip = outlined ? (SSD1353Rect){0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1} : randomClip();
+
+    begin(display, canvas, clip);
+    canvas.drawTriangle(p[0].x, p[0].y, p[1].x, p[1].y, p[2].x, p[2].y, line, fill, true);
+    display.drawTriangle(p[0].x, p[0].y, p[1].x, p[1].y, p[2].x, p[2].y, line, fill, true);
+
+    int32_t area = cross(p[0].x, p[0].y, p[1].x, p[1].y, p[2].x, p[2].y);
+    if (area < 0) {
+      SSD1353Point swap = p[1];
+      p[1]              = p[2];
+      p[2]              = swap;
+      area              = -area;
+    }
+    bool missed = false, spilled = false;
+    uint8_t badX = 0, badY = 0;
+    for (y = 0; y < SSD1353_HEIGHT && area; y++)
+      for (x = 0; x < SSD1353_WIDTH; x++) {
+        bool inside = true, near = true;
+        for (uint8_t i = 0; i < 3; i++) {
+          const SSD1353Point& a = p[i];
+          const SSD1353Point& b = p[(i + 1) % 3];
+          int32_t side          = cross(a.x, a.y, b.x, b.y, x, y);
+          float length          = sqrtf((float)(b.x - a.x) * (b.x - a.x) + (float)(b.y - a.y) * (b.y - a.y));
+          inside                = inside && side > 0;
+          near                  = near && side >= -length;
+        }
+        uint16_t pixel = canvas.getPixel(x, y);
+        if ((inside && pixel == background.value) || (!near && pixel != background.value)) {
+          missed |= inside;
+          spilled |= !inside;
+          badX = x;
+          badY = y;
+        }
+      }
+    if (!CHECK(!missed, "triangle %u: %u,%u inside is not drawn", n, badX, badY) ||
+        !CHECK(!spilled, "triangle %u: %u,%u more than a pixel outside is drawn", n, badX, badY))
+      return;
+    for (uint8_t i = 0; i < 3 && outlined; i++)
+      if (!CHECK(canvas.getPixel(p[i].x, p[i].y) == line.value, "triangle %u: corner %u,%u is not outlined", n, p[i].x, p[i].y))
+        return;
+
+    memcpy(expected.buffer(), canvas.buffer(), sizeof(uint16_t) * SSD1353_WIDTH * SSD1353_HEIGHT);
+    maskOutside(expected, clip);
+    if (!end(display, "triangle", n))
+      return;
+  }
+}
+
+// Convex polygons from corners around an ellipse, the display against the canvas
+static void testPolygons() {
+  SSD1353& display      = testDisplay();
+  SSD1353Canvas& canvas = testCanvas();
+  SSD1353Point points[12];
+
+  testSeed(0x9015E000);
+  for (uint16_t n = 0; n < POLYGONS; n++) {
+    uint8_t count = 1 + testRandom(12);
+    float rx      = 1 + testRandom(80), ry = 1 + testRandom(64);
+    float cx      = testRandom(SSD1353_WIDTH), cy = testRandom(SSD1353_HEIGHT);
+    float angle   = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      angle += (2 * (float)M_PI / count) * (0.5f + testRandom(100) / 100.0f);
+      float px = cx + rx * cosf(angle), py = cy + ry * sinf(angle);
+      points[i].x = min(max(lroundf(px), 0L), SSD1353_WIDTH - 1L);
+      points[i].y = min(max(lroundf(py), 0L), SSD1353_HEIGHT - 1L);
+    }
+    bool useFill     = testRandom(3) != 0;
+    Color565 line    = testColor(4), fill = testRandom(2) ? line : testColor(4);
+    bool outlined    = !useFill || line != fill;
+    SSD1353Rect clip = outlined ? (SSD1353Rect){0, 0, SSD1353_WIDTH - 1, SSD1353_HEIGHT - 1} : randomClip();
+
+    begin(display, canvas, clip);
+    canvas.drawPolygon(points, count, line, fill, useFill);
+    display.drawPolygon(points, count, line, fill, useFill);
+    memcpy(expected.buffer(), canvas.buffer(), sizeof(uint16_t) * SSD1353_WIDTH * SSD1353_HEIGHT);
+    maskOutside(expected, clip);
+    if (!end(display, "polygon", n))
+      return;
+  }
+}
+
+void testShapes() {
+  testRound();
+  testTriangles();
+  testPolygons();
+  CHECK(panel.unknownCommands == 0, "%lu unknown commands", (unsigned long)panel.unknownCommands);
+}
@@ -0,0 +1,49 @@
+/*
+  Test.h - Checks and shared helpers of the host tests
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <Arduino.h>
+#include <stdio.h>
+
+#include "SSD1353.h"
+
+extern uint32_t testChecks;
+extern uint32_t testFailures;
+
+// Count a check, print it with a printf-style message when it fails.
+// Evaluates to the condition so random loops can stop at the first failure.
+#define CHECK(condition, ...) testCheck((condition), __FILE__, __LINE__, __VA_ARGS__)
+
+bool testCheck(bool passed, const char* file, int line, const char* format, ...);
+
+// Reproducible pseudo-random numbers, the same on every host
+void testSeed(uint32_t seed);
+uint32_t testRandom(uint32_t limit);
+Color565 testColor(uint8_t colors = 0); // One of the first colors of a fixed set, any color when 0
+
+// Random scene of the calls the display list optimizer rewrites
+void testScene(SSD1353Gfx& gfx);
+
+// Test suites, one per library part
+void testDisplayList();
+void testShapes();
+void testFrameDiff();
+void testImages();
+void testAsync();
+void testConsole();
+
+#endif
@@ -0,0 +1,83 @@
+/*
+  Tests.cpp - Host tests of the SSD1353 library against a model of the panel
+    Copyright (C) 2022 Paulus Kivelä
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <stdarg.h>
+
+#include "Test.h"
+
+uint32_t testChecks;
+uint32_t testFailures;
+
+static uint32_t randomState;
+
+static const uint16_t palette[] = {0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0xFFE0, 0x8410, 0x4A69};
+
+bool testCheck(bool passed, const char* file, int line, const char* format, ...) {
+  testChecks++;
+  if (passed)
+    return true;
+
+  testFailures++;
+  va_list args;
+  va_start(args, format);
+  printf("%s:%d: ", file, line);
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+  return false;
+}
+
+void testSeed(uint32_t seed) {
+  randomState = seed ? seed : 1;
+}
+
+// xorshift32
+uint32_t testRandom(uint32_t limit) {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return limit ? randomState % limit : 0;
+}
+
+Color565 testColor(uint8_t colors) {
+  const uint8_t count = sizeof(palette) / sizeof(palette[0]);
+  if (colors)
+    return Color565(palette[testRandom(min(colors, count))]);
+  return Color565((uint16_t)testRandom(0x10000));
+}
+
+int main() {
+  static const struct {
+    const char* name;
+    void (*run)();
+  } suites[] = {
+      {"display list", testDisplayList},
+      {"shapes", testShapes},
+      {"frame diff", testFrameDiff},
+      {"images", testImages},
+      {"async queue", testAsync},
+      {"console", testConsole},
+  };
+
+  for (const auto& suite : suites) {
+    uint32_t failures = testFailures;
+    uint32_t checks   = testChecks;
+    suite.run();
+    printf("%-16s %6lu checks, %lu failed\n", suite.name, (unsigned long)(testChecks - checks), (unsigned long)(testFailures - failures));
+  }
+
+  printf("%lu checks, %lu failed\n", (unsigned long)testChecks, (unsigned long)testFailures);
+  return testFailures ? 1 : 0;
+}
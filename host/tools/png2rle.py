@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+#
+#  png2rle.py - Convert PNG images to the SSD1353 run-length encoded format
+#    Copyright (C) 2022 Paulus Kivelä
+#    This program is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#    This program is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#    You should have received a copy of the GNU General Public License
+#    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+#
+# Usage: png2rle.py [--palette | --no-palette] [--max-palette N]
+#                   [--background RRGGBB] [--name NAME] [--binary]
+#                   input.png output
+#
+# Writes a C header with a PROGMEM array for SSD1353Base::drawImage, or with
+# --binary the raw image for drawImage from a Stream (SD card, serial).
+# Stream images keep their palette in RAM, so --binary limits the palette
+# to SSD1353_IMAGE_STREAM_PALETTE colors unless --max-palette says otherwise.
+# The format is described in SSD1353/SSD1353Image.h. Only the standard
+# library is used, PNGs must be non-interlaced.
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+RUN = 0x80
+MAX_PACKET = 128
+MAX_PALETTE = 255
+STREAM_PALETTE = 16  # SSD1353_IMAGE_STREAM_PALETTE
+
+
+def read_png(path):
+    """Return (width, height, rows) with rows of (r, g, b, a) tuples, top row first."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+
+    pos = 8
+    idat = b""
+    plte = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            plte = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            trns = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+
+    if interlace:
+        raise ValueError("interlaced PNGs are not supported")
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bits = depth * channels
+    stride = (width * bits + 7) // 8
+    step = max(1, bits // 8)
+
+    raw = zlib.decompress(idat)
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - step] if i >= step else 0
+            up = prev[i]
+            corner = prev[i - step] if i >= step else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xFF
+            elif kind == 4:
+                p = left + up - corner
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - corner)
+                pred = left if pa <= pb and pa <= pc else up if pb <= pc else corner
+                line[i] = (line[i] + pred) & 0xFF
+        prev = line
+
+        samples = []
+        if depth < 8:
+            for byte in line:
+                for shift in range(8 - depth, -1, -depth):
+                    samples.append((byte >> shift) & ((1 << depth) - 1))
+        elif depth == 16:
+            samples = list(line[0::2])
+        else:
+            samples = list(line)
+
+        row = []
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if color == 0:
+                v = s[0] * 255 // ((1 << depth) - 1) if depth < 8 else s[0]
+                row.append((v, v, v, 255))
+            elif color == 2:
+                row.append((s[0], s[1], s[2], 255))
+            elif color == 3:
+                alpha = trns[s[0]] if s[0] < len(trns) else 255
+                row.append(plte[s[0]] + (alpha,))
+            elif color == 4:
+                row.append((s[0], s[0], s[0], s[1]))
+            else:
+                row.append(tuple(s))
+        rows.append(row)
+    return width, height, rows
+
+
+def rgb565(r, g, b):
+    return ((r * 31 + 127) // 255) << 11 | ((g * 63 + 127) // 255) << 5 | ((b * 31 + 127) // 255)
+
+
+def encode(values, value_bytes):
+    """Run-length encode a list of pixel values, each packed into value_bytes."""
+    # A run is worth a packet once it saves more than the packet byte
+    min_run = 2 if value_bytes > 1 else 3
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            part = literal[:MAX_PACKET]
+            del literal[:MAX_PACKET]
+            out.append(len(part) - 1)
+            for v in part:
+                out.extend(v.to_bytes(value_bytes, "little"))
+
+    i = 0
+    while i < len(values):
+        n = 1
+        while i + n < len(values) and values[i + n] == values[i] and n < MAX_PACKET:
+            n += 1
+        if n >= min_run:
+            flush_literal()
+            out.append(RUN | (n - 1))
+            out.extend(values[i].to_bytes(value_bytes, "little"))
+        else:
+            literal.extend(values[i:i + n])
+        i += n
+    flush_literal()
+    return out
+
+
+def convert(width, height, rows, background, palette, max_palette=MAX_PALETTE):
+    if width > 255 or height > 255:
+        raise ValueError("images are limited to 255x255 pixels")
+    if not 0 <= max_palette <= MAX_PALETTE:
+        raise ValueError("palettes are limited to %d colors" % MAX_PALETTE)
+
+    colors = []
+    for row in reversed(rows):  # Bottom row first
+        for r, g, b, a in row:
+            r = (r * a + background[0] * (255 - a)) // 255
+            g = (g * a + background[1] * (255 - a)) // 255
+            b = (b * a + background[2] * (255 - a)) // 255
+            colors.append(rgb565(r, g, b))
+
+    unique = sorted(set(colors))
+    if palette is None:
+        palette = len(unique) <= max_palette and len(unique) < len(colors) // 2
+    if palette and len(unique) > max_palette:
+        raise ValueError("%d colors do not fit a palette of %d" % (len(unique), max_palette))
+
+    out = bytearray([width, height, len(unique) if palette else 0])
+    if palette:
+        # Most used colors first, so small palettes stay in the first entries
+        unique.sort(key=lambda c: -colors.count(c))
+        index = {c: i for i, c in enumerate(unique)}
+        for c in unique:
+            out.extend(c.to_bytes(2, "little"))
+        out.extend(encode([index[c] for c in colors], 1))
+    else:
+        out.extend(encode(colors, 2))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a PNG image to the SSD1353 RLE format")
+    parser.add_argument("input")
+    parser.add_argument("output")
+    group = parser.add_mutually_exclusive_group()
+    group.add_argument("--palette", dest="palette", action="store_true", default=None, help="always use a palette")
+    group.add_argument("--no-palette", dest="palette", action="store_false", help="always store RGB565 pixels")
+    parser.add_argument("--max-palette", type=int,
+                        help="largest palette, default %d or %d with --binary" % (MAX_PALETTE, STREAM_PALETTE))
+    parser.add_argument("--background", default="000000", help="color behind transparent pixels, RRGGBB")
+    parser.add_argument("--name", help="array name, defaults to the input file name")
+    parser.add_argument("--binary", action="store_true", help="write the raw image instead of a C header")
+    args = parser.parse_args()
+
+    background = tuple(int(args.background[i:i + 2], 16) for i in (0, 2, 4))
+    width, height, rows = read_png(args.input)
+    max_palette = args.max_palette
+    if max_palette is None:
+        max_palette = STREAM_PALETTE if args.binary else MAX_PALETTE
+    image = convert(width, height, rows, background, args.palette, max_palette)
+
+    if args.binary:
+        with open(args.output, "wb") as f:
+            f.write(image)
+    else:
+        name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.input))[0])
+        with open(args.output, "w") as f:
+            f.write("// %s: %dx%d, %d palette colors, %d bytes\n" % (os.path.basename(args.input), width, height, image[2], len(image)))
+            f.write("static const uint8_t %s[] PROGMEM = {\n" % name)
+            for i in range(0, len(image), 16):
+                f.write("    " + ", ".join("0x%02X" % b for b in image[i:i + 16]) + ",\n")
+            f.write("};\n")
+
+    print("%s: %dx%d, %d bytes (raw RGB565 %d)" % (args.output, width, height, len(image), width * height * 2), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()